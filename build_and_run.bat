@@ -26,7 +26,14 @@ if exist game.exe del game.exe
 echo [2/3] Compiling defense systems with Raylib...
 echo.
 
-g++ src/engine/main.cpp src/student/*.cpp -o game.exe -O2 -I src/engine -I src/engine/raylib/include -L src/engine/raylib/lib -lraylib -lopengl32 -lgdi32 -lwinmm 2> build_errors.txt
+set ENGINE_SOURCES=src/engine/main.cpp src/engine/Simulation.cpp src/engine/JobSystem.cpp src/engine/EnemyKernels.cpp src/engine/Replay.cpp src/engine/SaveState.cpp src/engine/WhatIf.cpp src/engine/PlacementPolicy.cpp src/engine/RadarView.cpp src/engine/Exercises.cpp
+
+:: Students who wrote the RadarView radar functions opt in with
+:: #define STUDENT_HAS_RADARVIEW in 04_Radar.cpp (see RadarView.cpp)
+set RADAR_FLAGS=
+findstr /B /C:"#define STUDENT_HAS_RADARVIEW" src\student\04_Radar.cpp >nul && set RADAR_FLAGS=-DSTUDENT_HAS_RADARVIEW=
+
+g++ %ENGINE_SOURCES% src/student/*.cpp -o game.exe -O2 %RADAR_FLAGS% -I src/engine -I src/engine/raylib/include -L src/engine/raylib/lib -lraylib -lopengl32 -lgdi32 -lwinmm 2> build_errors.txt
 
 if %errorlevel% neq 0 (
     color 0C
@@ -53,7 +60,7 @@ echo [3/3] Launching Planetary Defense Command...
 echo.
 echo ========================================
 
-game.exe
+game.exe %*
 
 echo.
 echo ========================================
@@ -67,8 +67,18 @@ rm -f game 2>/dev/null
 echo "[3/3] Compiling defense systems with Raylib..."
 echo ""
 
+# Engine translation units (students only edit src/student/)
+ENGINE_SOURCES="src/engine/main.cpp src/engine/Simulation.cpp src/engine/JobSystem.cpp src/engine/EnemyKernels.cpp src/engine/Replay.cpp src/engine/SaveState.cpp src/engine/WhatIf.cpp src/engine/PlacementPolicy.cpp src/engine/RadarView.cpp src/engine/Exercises.cpp"
+
+# Students who wrote the RadarView radar functions opt in with
+# #define STUDENT_HAS_RADARVIEW in 04_Radar.cpp (see RadarView.cpp)
+RADAR_FLAGS=""
+if grep -q "^#define STUDENT_HAS_RADARVIEW" src/student/04_Radar.cpp; then
+    RADAR_FLAGS="-DSTUDENT_HAS_RADARVIEW="
+fi
+
 # Compile with g++
-g++ src/engine/main.cpp src/student/*.cpp -o game -O2 \
+g++ $ENGINE_SOURCES src/student/*.cpp -o game -O2 $RADAR_FLAGS \
     -I src/engine \
     $RAYLIB_INCLUDE \
     $RAYLIB_LIB \
@@ -101,7 +111,7 @@ echo "  LAUNCHING GAME..."
 echo "========================================"
 echo ""
 
-./game
+./game "$@"
 
 echo ""
 echo "Game closed. Thanks for playing!"
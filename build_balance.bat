@@ -0,0 +1,45 @@
+@echo off
+title Planetary Defense Command - Balance Build
+
+:: ═══════════════════════════════════════════════════════════════════════
+::  Builds the balance runner (no Raylib, no display needed) and runs it.
+::  Any arguments are passed to the runner, e.g.:
+::    build_balance.bat --games 5000 --csv balance.csv
+:: ═══════════════════════════════════════════════════════════════════════
+
+echo ========================================
+echo   PLANETARY DEFENSE BALANCE BUILD
+echo ========================================
+echo.
+
+echo [1/2] Compiling balance runner...
+if exist balance.exe del balance.exe
+
+set ENGINE_SOURCES=src/engine/balance.cpp src/engine/Simulation.cpp src/engine/JobSystem.cpp src/engine/EnemyKernels.cpp src/engine/Replay.cpp src/engine/SaveState.cpp src/engine/RadarView.cpp src/engine/PlacementPolicy.cpp
+
+:: Students who wrote the RadarView radar functions opt in with
+:: #define STUDENT_HAS_RADARVIEW in 04_Radar.cpp (see RadarView.cpp)
+set RADAR_FLAGS=
+findstr /B /C:"#define STUDENT_HAS_RADARVIEW" src\student\04_Radar.cpp >nul && set RADAR_FLAGS=-DSTUDENT_HAS_RADARVIEW=
+
+g++ %ENGINE_SOURCES% src/student/*.cpp -o balance.exe -O2 %RADAR_FLAGS% -I src/engine 2> build_errors.txt
+
+if %errorlevel% neq 0 (
+    echo ========================================
+    echo   [ERROR] COMPILATION FAILED!
+    echo ========================================
+    echo.
+    echo --- Error Details ---
+    type build_errors.txt
+    echo.
+    del build_errors.txt
+    exit /b 1
+)
+
+del build_errors.txt
+echo [OK] Compilation successful!
+echo.
+
+echo [2/2] Running balance games...
+echo.
+balance.exe %*
@@ -0,0 +1,51 @@
+#!/bin/bash
+
+# ═══════════════════════════════════════════════════════════════════════
+#  PLANETARY DEFENSE COMMAND - Headless Build & Run Script (Linux)
+# ═══════════════════════════════════════════════════════════════════════
+#  Builds the simulation WITHOUT Raylib (no window, no display needed)
+#  and runs it. Any arguments are passed to the runner, e.g.:
+#    ./build_headless.sh --games 1000 --seconds 300
+# ═══════════════════════════════════════════════════════════════════════
+
+echo "========================================"
+echo "  PLANETARY DEFENSE HEADLESS BUILD"
+echo "========================================"
+echo ""
+
+# Engine translation units (no graphics)
+ENGINE_SOURCES="src/engine/headless.cpp src/engine/Simulation.cpp src/engine/JobSystem.cpp src/engine/EnemyKernels.cpp src/engine/Replay.cpp src/engine/SaveState.cpp src/engine/RadarView.cpp src/engine/PlacementPolicy.cpp"
+
+# Students who wrote the RadarView radar functions opt in with
+# #define STUDENT_HAS_RADARVIEW in 04_Radar.cpp (see RadarView.cpp)
+RADAR_FLAGS=""
+if grep -q "^#define STUDENT_HAS_RADARVIEW" src/student/04_Radar.cpp; then
+    RADAR_FLAGS="-DSTUDENT_HAS_RADARVIEW="
+fi
+
+echo "[1/2] Compiling headless simulation..."
+rm -f headless 2>/dev/null
+
+g++ $ENGINE_SOURCES src/student/*.cpp -o headless -O2 $RADAR_FLAGS -pthread \
+    -I src/engine \
+    2> build_errors.txt
+
+if [ $? -ne 0 ]; then
+    echo "========================================"
+    echo "  [ERROR] COMPILATION FAILED!"
+    echo "========================================"
+    echo ""
+    echo "--- Error Details ---"
+    cat build_errors.txt
+    echo ""
+    rm -f build_errors.txt
+    exit 1
+fi
+
+rm -f build_errors.txt
+echo "[OK] Compilation successful!"
+echo ""
+
+echo "[2/2] Running simulation..."
+echo ""
+./headless "$@"
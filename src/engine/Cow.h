@@ -0,0 +1,106 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════
+ *  PLANETARY DEFENSE COMMAND - Copy-on-Write Arrays
+ * ═══════════════════════════════════════════════════════════════════════
+ *  An array stored as fixed-size chunks that several GameWorlds can
+ *  share. Copying a CowArray only copies the list of chunk pointers and
+ *  marks every chunk as shared. A shared chunk is never written again:
+ *  whoever writes to it first gets a copy of their own, so a forked
+ *  world (see forkWorld()) only pays for the chunks it changes.
+ *  Reading goes through operator[] (never copies), writing through
+ *  edit(). Whether a chunk is shared is its own flag, not a reference
+ *  count that another thread may be changing, so worlds sharing chunks
+ *  may run on different threads once the copy has been made.
+ *  NOTE: This file is part of the engine - students should NOT edit this.
+ * ═══════════════════════════════════════════════════════════════════════
+ */
+
+#ifndef COW_H
+#define COW_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+template <typename T, int CHUNK_SIZE>
+struct CowArray {
+    struct Chunk {
+        T items[CHUNK_SIZE];
+        std::atomic<bool> shared{false};   // Set once, by the first copy of an array holding it
+
+        Chunk() : items() {}
+        Chunk(const Chunk& other) {
+            for (int i = 0; i < CHUNK_SIZE; i++) items[i] = other.items[i];
+        }
+    };
+
+    std::vector<std::shared_ptr<Chunk> > chunks;
+    int count = 0;
+
+    CowArray() = default;
+    CowArray(CowArray&&) = default;
+    CowArray& operator=(CowArray&&) = default;
+
+    CowArray(const CowArray& other) : chunks(other.chunks), count(other.count) {
+        markShared();
+    }
+
+    CowArray& operator=(const CowArray& other) {
+        if (this != &other) {
+            chunks = other.chunks;
+            count = other.count;
+            markShared();
+        }
+        return *this;
+    }
+
+    int size() const { return count; }
+    int chunkCount() const { return (int)chunks.size(); }
+
+    // Indices are never negative: unsigned division is a plain shift
+    const T& operator[](int index) const {
+        return chunks[(unsigned)index / CHUNK_SIZE]->items[(unsigned)index % CHUNK_SIZE];
+    }
+
+    // Writable element; copies its chunk first if another array shares it
+    T& edit(int index) {
+        return editChunk((unsigned)index / CHUNK_SIZE)[(unsigned)index % CHUNK_SIZE];
+    }
+
+    // Elements [c * CHUNK_SIZE, (c + 1) * CHUNK_SIZE), for loops that
+    // walk whole chunks (e.g. the SIMD enemy kernels)
+    const T* chunkData(int c) const { return chunks[c]->items; }
+
+    T* editChunk(int c) {
+        if (chunks[c]->shared.load(std::memory_order_acquire)) chunks[c] = std::make_shared<Chunk>(*chunks[c]);
+        return chunks[c]->items;
+    }
+
+    // Both arrays now point at every chunk: from here on, nobody writes them
+    void markShared() {
+        for (const std::shared_ptr<Chunk>& chunk : chunks) chunk->shared.store(true, std::memory_order_release);
+    }
+
+    // Added chunks are value-initialised. Shrinking only drops whole
+    // chunks, so an element cut off and added back keeps its old value.
+    void resize(int newCount) {
+        int needed = (newCount + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        while ((int)chunks.size() > needed) chunks.pop_back();
+        while ((int)chunks.size() < needed) chunks.push_back(std::make_shared<Chunk>());
+        count = newCount;
+    }
+
+    // Every element equal to value, in chunks of its own
+    void assign(int newCount, const T& value) {
+        chunks.clear();
+        resize(newCount);
+        for (int i = 0; i < newCount; i++) chunks[i / CHUNK_SIZE]->items[i % CHUNK_SIZE] = value;
+    }
+
+    void clear() {
+        chunks.clear();
+        count = 0;
+    }
+};
+
+#endif // COW_H
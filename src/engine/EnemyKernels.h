@@ -0,0 +1,38 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════
+ *  PLANETARY DEFENSE COMMAND - Enemy Kernels
+ * ═══════════════════════════════════════════════════════════════════════
+ *  Vectorized inner loops over the packed enemy arrays (see EnemyStore).
+ *  The best implementation for the CPU (AVX2, SSE2 or plain scalar) is
+ *  picked once at startup; every version gives bit-identical results.
+ *  NOTE: This file is part of the engine - students should NOT edit this.
+ * ═══════════════════════════════════════════════════════════════════════
+ */
+
+#ifndef ENEMY_KERNELS_H
+#define ENEMY_KERNELS_H
+
+// Packed grid cell of a position: (cellY << 16) | cellX, where
+// cellX = (int)((x - originX) / cellSize) and the same for y
+inline int packEnemyCell(float x, float y, float originX, float originY, float cellSize) {
+    int cellX = (int)((x - originX) / cellSize);
+    int cellY = (int)((y - originY) / cellSize);
+    return (cellY << 16) | cellX;
+}
+
+// Move every enemy by (x, y) += (velX, velY) * deltaTime and write the
+// indices of the enemies whose packed cell (see packEnemyCell) is no
+// longer cell[i] to `changed`, in increasing order. cell[] is not
+// updated. `changed` must have room for `count` entries.
+// Returns the number of enemies that changed cell.
+int moveEnemiesAndFindCellChanges(float* x, float* y, const float* velX, const float* velY,
+                                  const int* cell, int count, float deltaTime,
+                                  float originX, float originY, float cellSize, int* changed);
+
+// Name of the active implementation: "avx2", "sse2" or "scalar"
+const char* getEnemyKernelName();
+
+// Force an implementation by name (for testing); false if unsupported
+bool setEnemyKernel(const char* name);
+
+#endif // ENEMY_KERNELS_H
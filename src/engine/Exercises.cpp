@@ -0,0 +1,189 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════
+ *  PLANETARY DEFENSE COMMAND - Exercise Probes
+ * ═══════════════════════════════════════════════════════════════════════
+ *  The expected answers are the examples given in the exercise hints.
+ *  NOTE: This file is part of the engine - students should NOT edit this.
+ * ═══════════════════════════════════════════════════════════════════════
+ */
+
+#include "Exercises.h"
+#include "GameEngine.h"
+#include <cmath>
+
+bool exerciseSolved[EXERCISE_COUNT];
+
+static bool sameValue(double a, double b) {
+    return fabs(a - b) < 0.001;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// TEST DATA
+// ═══════════════════════════════════════════════════════════════════════
+
+static vector<RadarEnemy> probeRadar() {
+    vector<RadarEnemy> list;
+    list.push_back({ 1.0, 30, true });
+    list.push_back({ 4.0, 80, false });
+    list.push_back({ 7.0, 120, true });
+    return list;
+}
+
+static UpgradeTower probeTower(const string& type, int level, int damage, int kills) {
+    UpgradeTower tower;
+    tower.level = level;
+    tower.damage = damage;
+    tower.range = 2.0;
+    tower.type = type;
+    tower.kills = kills;
+    return tower;
+}
+
+static UpgradePlayer probePlayer(int totalKills, int wavesCompleted, bool isPremium) {
+    UpgradePlayer player;
+    player.name = "Probe";
+    player.money = 0;
+    player.totalKills = totalKills;
+    player.wavesCompleted = wavesCompleted;
+    player.isPremium = isPremium;
+    return player;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// PROBES
+// ═══════════════════════════════════════════════════════════════════════
+
+static bool probeExercise(Exercise exercise) {
+    switch (exercise) {
+        // 01_Economy.cpp
+        case EX_STARTING_MONEY:    return getStartingMoney() == 500;
+        case EX_BASE_HEALTH:       return getBaseHealth() == 100;
+        case EX_COMMANDER_NAME:    return getCommanderName() != "Unknown" && !getCommanderName().empty();
+        case EX_TOWER_COST:        return getTowerCost() == 100;
+        case EX_TOWER_BASE_DAMAGE: return getTowerBaseDamage() == 10;
+        case EX_TOWER_RANGE:       return sameValue(getTowerRange(), 3.0);
+        case EX_KILL_BONUS:        return getKillBonus() == 25;
+        case EX_WAVE_BONUS:        return getWaveBonus(5) == 100 && getWaveBonus(4) == 0;
+
+        // 02_Shop.cpp
+        case EX_CAN_AFFORD_TOWER:
+            return canAffordTower(100, 100) && !canAffordTower(99, 100);
+        case EX_TOWER_TYPE:
+            return getTowerType(600) == 3 && getTowerType(250) == 2 && getTowerType(150) == 1 && getTowerType(50) == 0;
+        case EX_CAN_BUILD_TOWER_AT:
+            return canBuildTowerAt(3, 3, true) && !canBuildTowerAt(3, 3, false) && !canBuildTowerAt(10, 3, true);
+        case EX_BASE_IN_DANGER:
+            return isBaseInDanger(20, 0) && isBaseInDanger(100, 5) && !isBaseInDanger(100, 0);
+        case EX_VIP_PLAYER:
+            return isVIPPlayer(0, 0, true) && isVIPPlayer(2000, 10, false) && !isVIPPlayer(2000, 5, false);
+        case EX_DISCOUNT:
+            return calculateDiscount(600, true) == 30 && calculateDiscount(300, true) == 20
+                   && calculateDiscount(600, false) == 15 && calculateDiscount(300, false) == 0;
+        case EX_SHOW_WARNING:
+            return shouldShowWarning(false, true) && shouldShowWarning(true, false) && !shouldShowWarning(true, true);
+
+        // 03_Targeting.cpp
+        case EX_ENEMY_IN_RANGE:    return isEnemyInRange(3.0, 3.0) && !isEnemyInRange(4.0, 3.0);
+        case EX_DAMAGE:            return calculateDamage(10, 2) == 20;
+        case EX_TOTAL_DAMAGE:      return calculateTotalDamage(10, 2, 3) == 60;
+        case EX_FIRE_RATE:         return calculateFireRate(100, 1) == 50;
+        case EX_GRID_DISTANCE:     return sameValue(calculateGridDistance(0, 0, 3, 4), 5.0);
+        case EX_SELECT_TARGET:     return selectTarget(5, 2, 8) == 2 && selectTarget(5, 6, 1) == 3;
+        case EX_BONUS_DAMAGE:      return calculateBonusDamage(10, 40, 2) == 24 && calculateBonusDamage(10, 80, 2) == 20;
+        case EX_PREDICT_POSITION:  return sameValue(predictEnemyPosition(10, 2, 5), 20.0);
+
+        // 04_Radar.cpp
+        case EX_COUNT_ALL_ENEMIES:     return countAllEnemies(probeRadar()) == 3;
+        case EX_COUNT_CLOSE_ENEMIES:   return countCloseEnemies(probeRadar(), 5.0) == 2;
+        case EX_TOTAL_ENEMY_HEALTH:    return getTotalEnemyHealth(probeRadar()) == 230;
+        case EX_CLOSEST_ENEMY:         return sameValue(findClosestEnemy(probeRadar()), 1.0);
+        case EX_STRONGEST_ENEMY:       return findStrongestEnemy(probeRadar()) == 120;
+        case EX_FLYING_IN_RANGE:       return countFlyingEnemiesInRange(probeRadar(), 5.0) == 1;
+        case EX_SIMULATE_WAITING:      return simulateWaiting(1, 10) == 3;
+        case EX_FIRST_DANGEROUS_ENEMY: return findFirstDangerousEnemy(probeRadar(), 75) == 1;
+        case EX_COUNTDOWN_SUM:         return countdownSum(5) == 15;
+        case EX_COUNT_GRID_CELLS:      return countGridCells(3, 4) == 12;
+
+        // 05_Upgrades.cpp
+        case EX_UPGRADE_COST:
+            return getUpgradeCost(probeTower("laser", 3, 10, 0)) == 150
+                   && getUpgradeCost(probeTower("missile", 2, 10, 0)) == 150
+                   && getUpgradeCost(probeTower("plasma", 1, 10, 0)) == 100;
+        case EX_CAN_UPGRADE:
+            return canUpgrade(probeTower("laser", 1, 10, 0), 1000)
+                   && !canUpgrade(probeTower("laser", 5, 10, 0), 1000)
+                   && !canUpgrade(probeTower("laser", 1, 10, 0), 10);
+        case EX_UPGRADED_DAMAGE:
+            return getUpgradedDamage(probeTower("laser", 1, 10, 0)) == 15;
+        case EX_UPGRADED_RANGE:
+            return sameValue(getUpgradedRange(probeTower("laser", 1, 10, 0)), 2.2);
+        case EX_KILL_BONUS_DAMAGE:
+            return getBonusDamageFromKills(probeTower("laser", 1, 10, 25)) == 2;
+        case EX_FLEET_DAMAGE: {
+            vector<UpgradeTower> fleet;
+            fleet.push_back(probeTower("laser", 1, 10, 25));
+            fleet.push_back(probeTower("laser", 1, 5, 0));
+            return getTotalFleetDamage(fleet) == 17;
+        }
+        case EX_MVP_TOWER: {
+            vector<UpgradeTower> fleet;
+            fleet.push_back(probeTower("laser", 1, 10, 1));
+            fleet.push_back(probeTower("laser", 1, 10, 9));
+            fleet.push_back(probeTower("laser", 1, 10, 3));
+            return findMVPTower(fleet) == 1;
+        }
+        case EX_PLAYER_RANK:
+            return getPlayerRank(probePlayer(150, 0, false)) == "Βετεράνος"
+                   && getPlayerRank(probePlayer(5, 0, false)) == "Νεοσύλλεκτος";
+        case EX_DAILY_BONUS:
+            return calculateDailyBonus(probePlayer(0, 10, true), 3) == 120;
+        case EX_RECOMMEND_TOWER:
+            return recommendTower(120, true, 1) == "missile" && recommendTower(200, false, 12) == "plasma"
+                   && recommendTower(60, false, 1) == "laser" && recommendTower(10, false, 1) == "none";
+        case EX_AUTO_UPGRADE_ALL: {
+            // If money was spent, the function works
+            vector<UpgradeTower> fleet;
+            fleet.push_back(probeTower("laser", 1, 10, 0));
+            return autoUpgradeAll(fleet, 1000) < 1000;
+        }
+        default:
+            return false;
+    }
+}
+
+void probeExercises() {
+    for (int i = 0; i < EXERCISE_COUNT; i++) {
+        exerciseSolved[i] = probeExercise((Exercise)i);
+    }
+}
+
+bool isExerciseSolved(Exercise exercise) {
+    return exercise >= 0 && exercise < EXERCISE_COUNT && exerciseSolved[exercise];
+}
+
+int countSolvedExercises() {
+    int solved = 0;
+    for (int i = 0; i < EXERCISE_COUNT; i++) {
+        if (exerciseSolved[i]) solved++;
+    }
+    return solved;
+}
+
+const char* getExerciseName(Exercise exercise) {
+    static const char* names[EXERCISE_COUNT] = {
+        "getStartingMoney", "getBaseHealth", "getCommanderName", "getTowerCost",
+        "getTowerBaseDamage", "getTowerRange", "getKillBonus", "getWaveBonus",
+        "canAffordTower", "getTowerType", "canBuildTowerAt", "isBaseInDanger",
+        "isVIPPlayer", "calculateDiscount", "shouldShowWarning",
+        "isEnemyInRange", "calculateDamage", "calculateTotalDamage", "calculateFireRate",
+        "calculateGridDistance", "selectTarget", "calculateBonusDamage", "predictEnemyPosition",
+        "countAllEnemies", "countCloseEnemies", "getTotalEnemyHealth",
+        "findClosestEnemy", "findStrongestEnemy", "countFlyingEnemiesInRange", "simulateWaiting",
+        "findFirstDangerousEnemy", "countdownSum", "countGridCells",
+        "getUpgradeCost", "canUpgrade", "getUpgradedDamage", "getUpgradedRange",
+        "getBonusDamageFromKills", "getTotalFleetDamage", "findMVPTower", "getPlayerRank",
+        "calculateDailyBonus", "recommendTower", "autoUpgradeAll"
+    };
+    if (exercise < 0 || exercise >= EXERCISE_COUNT) return "?";
+    return names[exercise];
+}
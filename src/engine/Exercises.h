@@ -0,0 +1,47 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════
+ *  PLANETARY DEFENSE COMMAND - Exercise Probes
+ * ═══════════════════════════════════════════════════════════════════════
+ *  Checks which student exercises are solved by calling each one once
+ *  with a known input and comparing against the expected answer.
+ *  The results are cached, so the UI can ask "is this solved?" every
+ *  frame without running student code (which may loop heavily). The
+ *  [E] panel of the game lists every result.
+ *  NOTE: This file is part of the engine - students should NOT edit this.
+ * ═══════════════════════════════════════════════════════════════════════
+ */
+
+#ifndef EXERCISES_H
+#define EXERCISES_H
+
+// One entry per student function declared in GameEngine.h
+enum Exercise {
+    // 01_Economy.cpp
+    EX_STARTING_MONEY, EX_BASE_HEALTH, EX_COMMANDER_NAME, EX_TOWER_COST,
+    EX_TOWER_BASE_DAMAGE, EX_TOWER_RANGE, EX_KILL_BONUS, EX_WAVE_BONUS,
+    // 02_Shop.cpp
+    EX_CAN_AFFORD_TOWER, EX_TOWER_TYPE, EX_CAN_BUILD_TOWER_AT, EX_BASE_IN_DANGER,
+    EX_VIP_PLAYER, EX_DISCOUNT, EX_SHOW_WARNING,
+    // 03_Targeting.cpp
+    EX_ENEMY_IN_RANGE, EX_DAMAGE, EX_TOTAL_DAMAGE, EX_FIRE_RATE,
+    EX_GRID_DISTANCE, EX_SELECT_TARGET, EX_BONUS_DAMAGE, EX_PREDICT_POSITION,
+    // 04_Radar.cpp
+    EX_COUNT_ALL_ENEMIES, EX_COUNT_CLOSE_ENEMIES, EX_TOTAL_ENEMY_HEALTH,
+    EX_CLOSEST_ENEMY, EX_STRONGEST_ENEMY, EX_FLYING_IN_RANGE, EX_SIMULATE_WAITING,
+    EX_FIRST_DANGEROUS_ENEMY, EX_COUNTDOWN_SUM, EX_COUNT_GRID_CELLS,
+    // 05_Upgrades.cpp
+    EX_UPGRADE_COST, EX_CAN_UPGRADE, EX_UPGRADED_DAMAGE, EX_UPGRADED_RANGE,
+    EX_KILL_BONUS_DAMAGE, EX_FLEET_DAMAGE, EX_MVP_TOWER, EX_PLAYER_RANK,
+    EX_DAILY_BONUS, EX_RECOMMEND_TOWER, EX_AUTO_UPGRADE_ALL,
+
+    EXERCISE_COUNT
+};
+
+// Run every probe again (at startup, or after the student code changed)
+void probeExercises();
+
+bool isExerciseSolved(Exercise exercise);   // Cached result of the last probe
+const char* getExerciseName(Exercise exercise);
+int countSolvedExercises();
+
+#endif // EXERCISES_H
@@ -4,6 +4,11 @@
  * ═══════════════════════════════════════════════════════════════════════
  *  This file declares the functions that students implement.
  *  The engine calls these functions - students write the logic!
+ *
+ *  PURE FUNCTIONS ONLY: the engine calls them from several threads at
+ *  the same time (tower targeting, the [H] hint, the balance runner).
+ *  Each one must work out its answer from its parameters alone - no
+ *  static or global variables that change, no cout / file I/O.
  * ═══════════════════════════════════════════════════════════════════════
  */
 
@@ -41,6 +46,8 @@ bool shouldShowWarning(bool hasEnoughMoney, bool towerSlotAvailable);
 // ═══════════════════════════════════════════════════════════════════════
 // FROM 03_Targeting.cpp - Συναρτήσεις & Μαθηματικά
 // ═══════════════════════════════════════════════════════════════════════
+// Called by every tower in parallel during its targeting (see the note
+// at the top: pure functions only)
 bool isEnemyInRange(double distance, double range);
 int calculateDamage(int baseDamage, int level);
 int calculateTotalDamage(int baseDamage, int level, int critMultiplier);
@@ -70,6 +77,32 @@ int findFirstDangerousEnemy(vector<RadarEnemy> enemies, int dangerThreshold);
 int countdownSum(int start);
 int countGridCells(int width, int height);
 
+// Read-only view of a radar list, so the engine can hand the same list
+// to every radar function without copying it. It is used exactly like
+// the vector: enemies.size(), enemies[i] and range-for all work.
+struct RadarView {
+    const RadarEnemy* items;
+    size_t count;
+
+    RadarView(const vector<RadarEnemy>& list) : items(list.data()), count(list.size()) {}
+    size_t size() const { return count; }
+    const RadarEnemy& operator[](size_t i) const { return items[i]; }
+    const RadarEnemy* begin() const { return items; }
+    const RadarEnemy* end() const { return items + count; }
+};
+
+// BONUS: the same exercises taking a RadarView. The engine calls these.
+// Write all of them in 04_Radar.cpp together with the line
+// #define STUDENT_HAS_RADARVIEW; until then the engine copies the view
+// into a vector and calls the versions above instead (RadarView.cpp).
+int countAllEnemies(RadarView enemies);
+int countCloseEnemies(RadarView enemies, double maxDistance);
+int getTotalEnemyHealth(RadarView enemies);
+double findClosestEnemy(RadarView enemies);
+int findStrongestEnemy(RadarView enemies);
+int countFlyingEnemiesInRange(RadarView enemies, double range);
+int findFirstDangerousEnemy(RadarView enemies, int dangerThreshold);
+
 // ═══════════════════════════════════════════════════════════════════════
 // FROM 05_Upgrades.cpp - Συνδυασμός Όλων (Variables + If/Else + Loops + Functions)
 // ═══════════════════════════════════════════════════════════════════════
@@ -0,0 +1,172 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════
+ *  PLANETARY DEFENSE COMMAND - Job System
+ * ═══════════════════════════════════════════════════════════════════════
+ *  Workers sleep on a condition variable between loops. Each queue has
+ *  its own lock, so threads only meet when one of them steals. Every job
+ *  carries the loop it belongs to, so loops from several threads (or a
+ *  loop started inside a job) can be queued at the same time.
+ *  NOTE: This file is part of the engine - students should NOT edit this.
+ * ═══════════════════════════════════════════════════════════════════════
+ */
+
+#include "JobSystem.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+const int MAX_JOB_THREADS = 64;
+
+// One parallelFor() call, owned by the caller's stack frame. The caller
+// returns only after jobsLeft dropped to 0 under doneLock, so no thread
+// touches the loop after that.
+struct JobLoop {
+    const std::function<void(int, int)>* body;
+    int jobsLeft;
+    std::mutex doneLock;
+    std::condition_variable doneSignal;
+};
+
+struct Job {
+    JobLoop* loop;
+    int begin;
+    int end;
+};
+
+struct JobQueue {
+    std::mutex lock;
+    std::deque<Job> jobs;
+};
+
+// Queue 0 belongs to the thread calling parallelFor(), queue i to worker i
+std::vector<std::unique_ptr<JobQueue> > jobQueues;
+std::vector<std::thread> jobWorkers;
+int jobThreadCount = 1;
+thread_local int jobQueueIndex = 0;   // Worker i uses queue i, every other thread queue 0
+
+std::mutex wakeLock;
+std::condition_variable wakeSignal;
+unsigned wakeGeneration = 0;   // Bumped for every parallelFor()
+bool jobsStopping = false;
+
+// Workers must be joined before the program exits, however it exits
+struct JobSystemShutdown {
+    ~JobSystemShutdown() { stopJobSystem(); }
+} jobSystemShutdown;
+
+// Own queue from the front, then other queues from the back
+static bool takeJob(int self, Job& job) {
+    int queueCount = (int)jobQueues.size();
+    for (int k = 0; k < queueCount; k++) {
+        JobQueue& queue = *jobQueues[(self + k) % queueCount];
+        std::lock_guard<std::mutex> guard(queue.lock);
+        if (queue.jobs.empty()) continue;
+        if (k == 0) {
+            job = queue.jobs.front();
+            queue.jobs.pop_front();
+        } else {
+            job = queue.jobs.back();
+            queue.jobs.pop_back();
+        }
+        return true;
+    }
+    return false;
+}
+
+static void runJob(const Job& job) {
+    (*job.loop->body)(job.begin, job.end);
+
+    std::lock_guard<std::mutex> guard(job.loop->doneLock);
+    if (--job.loop->jobsLeft == 0) job.loop->doneSignal.notify_all();
+}
+
+// Run queued jobs (of any loop) until every queue is empty
+static void runJobs(int self) {
+    Job job;
+    while (takeJob(self, job)) runJob(job);
+}
+
+static void workerMain(int self) {
+    jobQueueIndex = self;
+    unsigned seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(wakeLock);
+            wakeSignal.wait(lock, [&] { return jobsStopping || wakeGeneration != seen; });
+            if (jobsStopping) return;
+            seen = wakeGeneration;
+        }
+        runJobs(self);
+    }
+}
+
+void startJobSystem(int threadCount) {
+    stopJobSystem();
+
+    if (threadCount <= 0) threadCount = (int)std::thread::hardware_concurrency();
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > MAX_JOB_THREADS) threadCount = MAX_JOB_THREADS;
+    jobThreadCount = threadCount;
+
+    for (int i = 0; i < threadCount; i++) {
+        jobQueues.push_back(std::unique_ptr<JobQueue>(new JobQueue()));
+    }
+    jobsStopping = false;
+    for (int i = 1; i < threadCount; i++) {
+        jobWorkers.emplace_back(workerMain, i);
+    }
+}
+
+void stopJobSystem() {
+    {
+        std::lock_guard<std::mutex> guard(wakeLock);
+        jobsStopping = true;
+    }
+    wakeSignal.notify_all();
+    for (std::thread& worker : jobWorkers) worker.join();
+
+    jobWorkers.clear();
+    jobQueues.clear();
+    jobThreadCount = 1;
+}
+
+int getJobThreadCount() {
+    return jobThreadCount;
+}
+
+void parallelFor(int count, int grain, const std::function<void(int, int)>& body) {
+    if (count <= 0) return;
+    if (grain < 1) grain = 1;
+
+    int chunks = (count + grain - 1) / grain;
+    if (jobWorkers.empty() || chunks == 1) {
+        body(0, count);
+        return;
+    }
+
+    // Deal the chunks out round-robin, then wake the workers
+    JobLoop loop;
+    loop.body = &body;
+    loop.jobsLeft = chunks;
+    int queueCount = (int)jobQueues.size();
+    for (int c = 0; c < chunks; c++) {
+        int end = (c + 1) * grain < count ? (c + 1) * grain : count;
+        JobQueue& queue = *jobQueues[(jobQueueIndex + c) % queueCount];
+        std::lock_guard<std::mutex> guard(queue.lock);
+        queue.jobs.push_back({ &loop, c * grain, end });
+    }
+    {
+        std::lock_guard<std::mutex> guard(wakeLock);
+        wakeGeneration++;
+    }
+    wakeSignal.notify_all();
+
+    // Help out while anything is queued, then sleep until the chunks
+    // still running on other threads are done
+    runJobs(jobQueueIndex);
+    std::unique_lock<std::mutex> lock(loop.doneLock);
+    loop.doneSignal.wait(lock, [&] { return loop.jobsLeft == 0; });
+}
@@ -0,0 +1,33 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════
+ *  PLANETARY DEFENSE COMMAND - Job System
+ * ═══════════════════════════════════════════════════════════════════════
+ *  A few worker threads with one job queue each. parallelFor() deals the
+ *  chunks of a loop out over the queues; a thread takes jobs from the
+ *  front of its own queue and, when that is empty, steals from the back
+ *  of another one, so uneven chunks still keep every core busy.
+ *  The calling thread works too and returns once every chunk is done.
+ *  NOTE: This file is part of the engine - students should NOT edit this.
+ * ═══════════════════════════════════════════════════════════════════════
+ */
+
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <functional>
+
+// Start threadCount - 1 workers (the caller is the last thread).
+// 0 = one thread per core, 1 = no workers: everything runs on the caller.
+void startJobSystem(int threadCount);
+void stopJobSystem();
+int getJobThreadCount();
+
+// Run body(begin, end) over [0, count) in chunks of at most `grain`.
+// Chunks may run in any order and on any thread, so the body must only
+// write data that belongs to its own indices. Loops of one chunk (or
+// with no workers started) run directly on the caller. Any thread may
+// call it, also from inside a body; each call only waits for its own
+// chunks. startJobSystem() and stopJobSystem() must not run during a loop.
+void parallelFor(int count, int grain, const std::function<void(int, int)>& body);
+
+#endif // JOB_SYSTEM_H
@@ -0,0 +1,45 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════
+ *  PLANETARY DEFENSE COMMAND - Scripted Placement Policy
+ * ═══════════════════════════════════════════════════════════════════════
+ *  Fills cells next to the enemy lanes, closest to the base first
+ *  (skipping cells that would wall the enemies off), and spends spare
+ *  money on upgrades once every slot is used.
+ *  NOTE: This file is part of the engine - students should NOT edit this.
+ * ═══════════════════════════════════════════════════════════════════════
+ */
+
+#include "PlacementPolicy.h"
+#include "Simulation.h"
+
+static const int laneOffsets[] = { 0, 1, -1, 2, -2, 3, -3, 4 };   // Rows around the HQ
+static const int LANE_ROWS = sizeof(laneOffsets) / sizeof(laneOffsets[0]);
+
+bool getPlacementCell(const GameWorld& world, int index, int& gridX, int& gridY) {
+    if (index < 0 || index >= (world.gridWidth - 1) * LANE_ROWS) return false;
+    gridX = world.gridWidth - 2 - index / LANE_ROWS;
+    gridY = getBaseRow(world) + laneOffsets[index % LANE_ROWS];
+    return true;
+}
+
+void runPlacementPolicy(GameWorld& world) {
+    if (world.towerCount < world.maxTowers && world.playerMoney >= world.economy.towerCost) {
+        int col, row;
+        for (int i = 0; getPlacementCell(world, i, col, row); i++) {
+            if (!isValidGridPos(world, col, row) || isBasePosition(world, col, row) || hasTowerAt(world, col, row)) continue;
+
+            // Only a blocked path is worth another cell: without credits
+            // or a slot, no cell will do this tick
+            BuildResult result = buildTowerAt(world, col, row);
+            if (result == BUILD_OK) return;
+            if (result != BUILD_BLOCKS_PATH) break;
+        }
+    }
+
+    // The same towers and money always give the same upgrades: only try
+    // again once the money has changed
+    if (world.towerCount >= world.maxTowers && world.playerMoney != world.policyUpgradeMoney) {
+        autoUpgradeTowers(world);
+        world.policyUpgradeMoney = world.playerMoney;
+    }
+}
@@ -0,0 +1,26 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════
+ *  PLANETARY DEFENSE COMMAND - Scripted Placement Policy
+ * ═══════════════════════════════════════════════════════════════════════
+ *  The "player" of the headless and balance runners. It only goes
+ *  through the normal player actions, so it follows the same rules
+ *  (and calls the same student functions) as someone clicking.
+ *  NOTE: This file is part of the engine - students should NOT edit this.
+ * ═══════════════════════════════════════════════════════════════════════
+ */
+
+#ifndef PLACEMENT_POLICY_H
+#define PLACEMENT_POLICY_H
+
+struct GameWorld;
+
+// Called once before every simulation tick
+void runPlacementPolicy(GameWorld& world);
+
+// The cells the policy (and the [H] hint, see WhatIf.h) tries, in order:
+// columns from the HQ outward, and in each the rows around the HQ row.
+// Gives cell number `index`, or false once index is past the last one.
+// The cell may be off the grid, on the base or taken.
+bool getPlacementCell(const GameWorld& world, int index, int& gridX, int& gridY);
+
+#endif // PLACEMENT_POLICY_H
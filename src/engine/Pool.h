@@ -0,0 +1,93 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════
+ *  PLANETARY DEFENSE COMMAND - Object Pool
+ * ═══════════════════════════════════════════════════════════════════════
+ *  Fixed slots with a free list: allocate() and release() are O(1) at
+ *  any pool size. When every slot is taken the pool grows by growBy
+ *  slots (up to maxCapacity, 0 = no limit). Slot indices never change,
+ *  so an index stays valid for as long as the slot is in use.
+ *  Slots live in copy-on-write chunks (see Cow.h): read them with [],
+ *  change them with edit().
+ *  NOTE: This file is part of the engine - students should NOT edit this.
+ * ═══════════════════════════════════════════════════════════════════════
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+#include "Cow.h"
+#include <vector>
+
+const int POOL_CHUNK_SIZE = 64;   // Slots per copy-on-write chunk
+
+template <typename T>
+struct Pool {
+    CowArray<T, POOL_CHUNK_SIZE> items;
+    std::vector<int> nextFree;   // Next free slot after slot i (-1 = end)
+    int freeHead = -1;           // First free slot (-1 = none)
+    int used = 0;
+    int growBy = 16;
+    int maxCapacity = 0;
+
+    // Drop every slot and start again with 'initialCapacity' free ones
+    void reset(int initialCapacity, int growStep, int maxSlots = 0) {
+        items.clear();
+        nextFree.clear();
+        freeHead = -1;
+        used = 0;
+        growBy = (growStep > 0) ? growStep : 1;
+        maxCapacity = maxSlots;
+        grow(initialCapacity);
+    }
+
+    // Mark every slot free again, keeping the memory
+    void clear() {
+        freeHead = -1;
+        for (int i = capacity() - 1; i >= 0; i--) {
+            nextFree[i] = freeHead;
+            freeHead = i;
+        }
+        used = 0;
+    }
+
+    // Index of a free slot, or -1 if the pool is at maxCapacity
+    int allocate() {
+        if (freeHead < 0) grow(growBy);
+        if (freeHead < 0) return -1;
+
+        int index = freeHead;
+        freeHead = nextFree[index];
+        nextFree[index] = -1;
+        used++;
+        return index;
+    }
+
+    void release(int index) {
+        nextFree[index] = freeHead;
+        freeHead = index;
+        used--;
+    }
+
+    int capacity() const { return items.size(); }
+    int size() const { return used; }
+    const T& operator[](int index) const { return items[index]; }
+    T& edit(int index) { return items.edit(index); }
+
+    // Add up to 'slots' free slots (fewer if maxCapacity is reached)
+    void grow(int slots) {
+        int oldCapacity = capacity();
+        int newCapacity = oldCapacity + slots;
+        if (maxCapacity > 0 && newCapacity > maxCapacity) newCapacity = maxCapacity;
+        if (newCapacity <= oldCapacity) return;
+
+        items.resize(newCapacity);
+        nextFree.resize(newCapacity);
+        // New slots go on the free list lowest index first
+        for (int i = newCapacity - 1; i >= oldCapacity; i--) {
+            nextFree[i] = freeHead;
+            freeHead = i;
+        }
+    }
+};
+
+#endif // POOL_H
@@ -0,0 +1,51 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════
+ *  PLANETARY DEFENSE COMMAND - Radar View Fallbacks
+ * ═══════════════════════════════════════════════════════════════════════
+ *  Default versions of the RadarView radar functions: they copy the
+ *  view into a vector and call the vector exercise, exactly as before.
+ *  A student who writes all of the RadarView versions in 04_Radar.cpp
+ *  adds the line #define STUDENT_HAS_RADARVIEW there; the build scripts
+ *  then pass the same define to every file, these are left out and the
+ *  engine reads the radar list without copying it.
+ *  NOTE: This file is part of the engine - students should NOT edit this.
+ * ═══════════════════════════════════════════════════════════════════════
+ */
+
+#include "GameEngine.h"
+
+#ifndef STUDENT_HAS_RADARVIEW
+
+static vector<RadarEnemy> toVector(RadarView enemies) {
+    return vector<RadarEnemy>(enemies.begin(), enemies.end());
+}
+
+int countAllEnemies(RadarView enemies) {
+    return countAllEnemies(toVector(enemies));
+}
+
+int countCloseEnemies(RadarView enemies, double maxDistance) {
+    return countCloseEnemies(toVector(enemies), maxDistance);
+}
+
+int getTotalEnemyHealth(RadarView enemies) {
+    return getTotalEnemyHealth(toVector(enemies));
+}
+
+double findClosestEnemy(RadarView enemies) {
+    return findClosestEnemy(toVector(enemies));
+}
+
+int findStrongestEnemy(RadarView enemies) {
+    return findStrongestEnemy(toVector(enemies));
+}
+
+int countFlyingEnemiesInRange(RadarView enemies, double range) {
+    return countFlyingEnemiesInRange(toVector(enemies), range);
+}
+
+int findFirstDangerousEnemy(RadarView enemies, int dangerThreshold) {
+    return findFirstDangerousEnemy(toVector(enemies), dangerThreshold);
+}
+
+#endif // STUDENT_HAS_RADARVIEW
@@ -0,0 +1,78 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════
+ *  PLANETARY DEFENSE COMMAND - Input Recording & Replay
+ * ═══════════════════════════════════════════════════════════════════════
+ *  Every player action that changes the game goes through a command.
+ *  Because the simulation is deterministic (fixed ticks + seeded RNG),
+ *  a seed plus the list of (tick, command) pairs reproduces a whole
+ *  session, and it can be played back without rendering at full speed.
+ *  NOTE: This file is part of the engine - students should NOT edit this.
+ * ═══════════════════════════════════════════════════════════════════════
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <cstdint>
+#include <vector>
+
+struct GameWorld;
+
+// ═══════════════════════════════════════════════════════════════════════
+// COMMANDS
+// ═══════════════════════════════════════════════════════════════════════
+enum CommandType : uint8_t {
+    CMD_BUILD_TOWER = 1,    // x, y = grid cell
+    CMD_UPGRADE_TOWER = 2,  // x, y = grid cell of the tower
+    CMD_AUTO_UPGRADE = 3,
+    CMD_TOGGLE_PAUSE = 4,
+    CMD_RESTART = 5         // New game with seed gameSeed + 1
+};
+
+struct GameCommand {
+    uint32_t tick;          // simTick the command was applied at
+    uint8_t type;           // CommandType
+    int16_t x, y;
+};
+
+// Apply a command to a game (no recording)
+void applyCommand(GameWorld& world, const GameCommand& cmd);
+
+// Apply a command now, and append it to the recording if one is active.
+// Input handling calls this instead of the action functions directly.
+void issueCommand(GameWorld& world, CommandType type, int x = 0, int y = 0);
+
+// ═══════════════════════════════════════════════════════════════════════
+// REPLAY LOG
+// ═══════════════════════════════════════════════════════════════════════
+// File layout (little endian):
+//   "PDRP"  u16 version  u64 seed  u32 endTick  u32 count
+//   u16 maxTowers  u16 maxEnemies                  (version 2 and later)
+//   u16 gridWidth  u16 gridHeight                  (version 3 and later)
+//   count x { u32 tick  u8 type  i16 x  i16 y }   (9 bytes each)
+struct ReplayLog {
+    uint64_t seed;          // Seed of the first game
+    uint32_t endTick;       // simTick when the recording stopped
+    int maxTowers;          // Capacity the game was played with
+    int maxEnemies;
+    int gridWidth;          // Map the game was played on
+    int gridHeight;
+    std::vector<GameCommand> commands;
+};
+
+// Start recording the game that initGame() just set up in `world`.
+// There is one recording: only one game can be recorded at a time.
+void startRecording(GameWorld& world);
+void stopRecording(GameWorld& world);
+bool isRecording();
+ReplayLog& getRecording(GameWorld& world);   // endTick is updated to the current simTick
+
+bool saveReplay(const char* path, const ReplayLog& log);
+bool loadReplay(const char* path, ReplayLog& log);
+
+// Re-run a log from the start in `world` as fast as possible, without rendering.
+// Returns false if the log does not fit the simulation (e.g. a command
+// scheduled past a game over).
+bool playReplay(GameWorld& world, const ReplayLog& log);
+
+#endif // REPLAY_H
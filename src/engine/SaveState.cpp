@@ -0,0 +1,453 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════
+ *  PLANETARY DEFENSE COMMAND - Save States
+ * ═══════════════════════════════════════════════════════════════════════
+ *  NOTE: This file is part of the engine - students should NOT edit this.
+ * ═══════════════════════════════════════════════════════════════════════
+ */
+
+#include "SaveState.h"
+#include "Simulation.h"
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+const uint16_t SAVE_STATE_VERSION = 1;
+
+// ═══════════════════════════════════════════════════════════════════════
+// BYTE STREAMS
+// ═══════════════════════════════════════════════════════════════════════
+// Written byte by byte (like replay files) so a save state is the same on
+// every platform. A writer without a buffer only counts, so the size and
+// the contents always come from the same code.
+
+struct SaveWriter {
+    unsigned char* out;   // nullptr = count only
+    size_t bytes;
+
+    void u8(uint8_t v) {
+        if (out) out[bytes] = v;
+        bytes++;
+    }
+    void u16(uint16_t v) { u8((uint8_t)v); u8((uint8_t)(v >> 8)); }
+    void u32(uint32_t v) { for (int i = 0; i < 4; i++) u8((uint8_t)(v >> (8 * i))); }
+    void u64(uint64_t v) { for (int i = 0; i < 8; i++) u8((uint8_t)(v >> (8 * i))); }
+    void i32(int v) { u32((uint32_t)v); }
+    void f32(float v) {
+        uint32_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+        u32(bits);
+    }
+    void f64(double v) {
+        uint64_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+        u64(bits);
+    }
+    void str(const std::string& s) {
+        uint16_t length = s.size() < 0xFFFF ? (uint16_t)s.size() : 0xFFFF;
+        u16(length);
+        if (out) memcpy(out + bytes, s.data(), length);
+        bytes += length;
+    }
+};
+
+// Every read is bounds-checked; past the end it returns 0 and clears ok
+struct SaveReader {
+    const unsigned char* in;
+    size_t size;
+    size_t pos;
+    bool ok;
+
+    uint8_t u8() {
+        if (pos >= size) { ok = false; return 0; }
+        return in[pos++];
+    }
+    uint16_t u16() { uint16_t lo = u8(); return (uint16_t)(lo | (u8() << 8)); }
+    uint32_t u32() {
+        uint32_t v = 0;
+        for (int i = 0; i < 4; i++) v |= (uint32_t)u8() << (8 * i);
+        return v;
+    }
+    uint64_t u64() {
+        uint64_t v = 0;
+        for (int i = 0; i < 8; i++) v |= (uint64_t)u8() << (8 * i);
+        return v;
+    }
+    int i32() { return (int)u32(); }
+    float f32() {
+        uint32_t bits = u32();
+        float v;
+        memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+    double f64() {
+        uint64_t bits = u64();
+        double v;
+        memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+    void str(std::string& s) {
+        uint16_t length = u16();
+        if (size - pos < length) { ok = false; return; }
+        s.assign((const char*)in + pos, length);
+        pos += length;
+    }
+};
+
+static uint32_t checksum(const unsigned char* data, size_t size) {
+    uint32_t hash = 2166136261u;   // FNV-1a
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// WRITING
+// ═══════════════════════════════════════════════════════════════════════
+// Pool slots keep their free-list links, so towers and projectiles built
+// after a restore get the same slots as in the original game.
+
+template <typename T>
+static void writePoolHeader(SaveWriter& w, const Pool<T>& pool) {
+    w.u32((uint32_t)pool.capacity());
+    w.i32(pool.freeHead);
+    w.i32(pool.used);
+    w.i32(pool.growBy);
+    w.i32(pool.maxCapacity);
+}
+
+static void writePayload(const GameWorld& world, SaveWriter& w) {
+    // Timing and random stream
+    w.u64(world.gameSeed);
+    w.u64(world.gameRng.state);
+    w.u64(world.gameRng.inc);
+    w.u32(world.simTick);
+    w.f32(world.simAccumulator);
+    w.f32(world.enemySpawnTimer);
+    w.f32(world.gameSpeed);
+    w.f32(world.messageTimer);
+    w.u8(world.gamePaused ? 1 : 0);
+    w.u8(world.gameOver ? 1 : 0);
+
+    // Game state
+    w.i32(world.playerMoney);
+    w.i32(world.baseHealth);
+    w.i32(world.score);
+    w.i32(world.wave);
+    w.i32(world.totalPlayerKills);
+    w.i32(world.towerCount);
+    w.i32(world.enemyCount);
+    w.i32(world.nextEnemyId);
+
+    // Map and capacity
+    w.u16((uint16_t)world.gridWidth);
+    w.u16((uint16_t)world.gridHeight);
+    w.u16((uint16_t)world.maxTowers);
+    w.u16((uint16_t)world.maxEnemies);
+
+    // Economy (as sampled from 01_Economy.cpp when the game started)
+    w.i32(world.economy.startingMoney);
+    w.i32(world.economy.baseHealth);
+    w.i32(world.economy.towerCost);
+    w.i32(world.economy.towerBaseDamage);
+    w.i32(world.economy.killBonus);
+    w.f64(world.economy.towerRange);
+    w.str(world.economy.commanderName);
+
+    w.str(world.statusMessage);
+
+    // Towers (only active slots carry data)
+    writePoolHeader(w, world.towers);
+    for (int i = 0; i < world.towers.capacity(); i++) {
+        const Tower& tower = world.towers[i];
+        w.i32(world.towers.nextFree[i]);
+        w.u8(tower.active ? 1 : 0);
+        if (!tower.active) continue;
+        w.u16((uint16_t)tower.gridX);
+        w.u16((uint16_t)tower.gridY);
+        w.f32(tower.cooldown);
+        w.i32(tower.kills);
+        w.u8((uint8_t)tower.level);
+        w.str(tower.type);
+    }
+
+    // Projectiles
+    writePoolHeader(w, world.projectiles);
+    for (int i = 0; i < world.projectiles.capacity(); i++) {
+        const Projectile& shot = world.projectiles[i];
+        w.i32(world.projectiles.nextFree[i]);
+        w.u8(shot.active ? 1 : 0);
+        if (!shot.active) continue;
+        w.f32(shot.x);
+        w.f32(shot.y);
+        w.f32(shot.targetX);
+        w.f32(shot.targetY);
+        w.f32(shot.speed);
+    }
+
+    // Enemies, in slot order
+    const EnemyStore& enemies = world.enemies;
+    w.u32((uint32_t)enemies.count);
+    for (int i = 0; i < enemies.count; i++) {
+        w.f32(enemies.x[i]);
+        w.f32(enemies.y[i]);
+        w.f32(enemies.speed[i]);
+        w.f32(enemies.velX[i]);
+        w.f32(enemies.velY[i]);
+        w.i32(enemies.cell[i]);
+        w.i32(enemies.health[i]);
+        w.i32(enemies.id[i]);
+    }
+}
+
+size_t getSaveStateSize(const GameWorld& world) {
+    SaveWriter counter = { nullptr, 0 };
+    writePayload(world, counter);
+    return SAVE_STATE_HEADER_BYTES + counter.bytes;
+}
+
+size_t writeSaveState(const GameWorld& world, unsigned char* buffer, size_t capacity) {
+    size_t total = getSaveStateSize(world);
+    if (!buffer || capacity < total) return 0;
+
+    SaveWriter payload = { buffer + SAVE_STATE_HEADER_BYTES, 0 };
+    writePayload(world, payload);
+
+    SaveWriter header = { buffer, 0 };
+    header.u8('P'); header.u8('D'); header.u8('S'); header.u8('S');
+    header.u16(SAVE_STATE_VERSION);
+    header.u32((uint32_t)payload.bytes);
+    header.u32(checksum(buffer + SAVE_STATE_HEADER_BYTES, payload.bytes));
+    return total;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// RESTORING
+// ═══════════════════════════════════════════════════════════════════════
+
+template <typename T>
+static int readPoolHeader(SaveReader& r, Pool<T>& pool, int capacityLimit) {
+    int capacity = (int)r.u32();
+    if (capacity < 0 || capacity > capacityLimit) r.ok = false;
+    if (!r.ok) return 0;
+    pool.items.resize(capacity);
+    pool.nextFree.resize(capacity);
+    pool.freeHead = r.i32();
+    pool.used = r.i32();
+    pool.growBy = r.i32();
+    pool.maxCapacity = r.i32();
+    return capacity;
+}
+
+// The free list must run through exactly the unused slots, so allocate()
+// can never step off the pool or hand out a slot that is in use
+template <typename T>
+static bool isValidPool(const Pool<T>& pool) {
+    int capacity = pool.capacity();
+    if (pool.freeHead < -1 || pool.freeHead >= capacity || pool.used < 0 || pool.used > capacity
+        || pool.growBy < 1 || pool.maxCapacity < 0) return false;
+
+    int active = 0;
+    for (int i = 0; i < capacity; i++) {
+        if (pool.nextFree[i] < -1 || pool.nextFree[i] >= capacity) return false;
+        if (pool[i].active) active++;
+    }
+    if (active != pool.used) return false;
+
+    // A chain that reaches -1 has no loop, so its slots are all different
+    int freeSlots = 0;
+    for (int i = pool.freeHead; i >= 0; i = pool.nextFree[i]) {
+        if (pool[i].active || ++freeSlots > capacity - pool.used) return false;
+    }
+    return freeSlots == capacity - pool.used;
+}
+
+static bool readPayload(GameWorld& world, SaveReader& r) {
+    world.gameSeed = r.u64();
+    world.gameRng.state = r.u64();
+    world.gameRng.inc = r.u64();
+    world.simTick = r.u32();
+    world.simAccumulator = r.f32();
+    world.enemySpawnTimer = r.f32();
+    world.gameSpeed = r.f32();
+    world.messageTimer = r.f32();
+    world.gamePaused = r.u8() != 0;
+    world.gameOver = r.u8() != 0;
+
+    world.playerMoney = r.i32();
+    world.baseHealth = r.i32();
+    world.score = r.i32();
+    world.wave = r.i32();
+    world.totalPlayerKills = r.i32();
+    world.towerCount = r.i32();
+    world.enemyCount = r.i32();
+    world.nextEnemyId = r.i32();
+
+    // Saved values were already clamped, so these only reject garbage
+    world.gridWidth = r.u16();
+    world.gridHeight = r.u16();
+    world.maxTowers = r.u16();
+    world.maxEnemies = r.u16();
+    if (world.gridWidth < MIN_GRID_SIZE || world.gridWidth > MAX_GRID_SIZE
+        || world.gridHeight < MIN_GRID_SIZE || world.gridHeight > MAX_GRID_SIZE
+        || world.maxTowers < 1 || world.maxTowers > MAX_TOWERS_LIMIT
+        || world.maxEnemies < 1 || world.maxEnemies > MAX_ENEMIES_LIMIT) return false;
+
+    world.economy.startingMoney = r.i32();
+    world.economy.baseHealth = r.i32();
+    world.economy.towerCost = r.i32();
+    world.economy.towerBaseDamage = r.i32();
+    world.economy.killBonus = r.i32();
+    world.economy.towerRange = r.f64();
+    r.str(world.economy.commanderName);
+
+    r.str(world.statusMessage);
+
+    // Towers
+    int towerSlots = readPoolHeader(r, world.towers, world.maxTowers);
+    for (int i = 0; i < towerSlots && r.ok; i++) {
+        Tower& tower = world.towers.edit(i);
+        world.towers.nextFree[i] = r.i32();
+        tower.active = r.u8() != 0;
+        if (!tower.active) {
+            tower.kills = 0;
+            tower.level = 1;
+            tower.type = "laser";
+            continue;
+        }
+        tower.gridX = r.u16();
+        tower.gridY = r.u16();
+        tower.cooldown = r.f32();
+        tower.kills = r.i32();
+        tower.level = r.u8();
+        r.str(tower.type);
+        if (!isValidGridPos(world, tower.gridX, tower.gridY)) return false;
+    }
+    if (!r.ok || !isValidPool(world.towers) || world.towerCount != world.towers.size()) return false;
+
+    // Projectiles (the pool has no limit; a slot takes at least 5 bytes)
+    int projectileSlots = readPoolHeader(r, world.projectiles, (int)(r.size / 5));
+    for (int i = 0; i < projectileSlots && r.ok; i++) {
+        Projectile& shot = world.projectiles.edit(i);
+        world.projectiles.nextFree[i] = r.i32();
+        shot.active = r.u8() != 0;
+        if (!shot.active) continue;
+        shot.x = r.f32();
+        shot.y = r.f32();
+        shot.targetX = r.f32();
+        shot.targetY = r.f32();
+        shot.speed = r.f32();
+    }
+    if (!r.ok || !isValidPool(world.projectiles)) return false;
+
+    // Enemies
+    EnemyStore& enemies = world.enemies;
+    int enemyTotal = (int)r.u32();
+    if (!r.ok || enemyTotal > world.maxEnemies) return false;
+    if (enemies.x.size() < enemyTotal) {
+        enemies.x.resize(enemyTotal);
+        enemies.y.resize(enemyTotal);
+        enemies.speed.resize(enemyTotal);
+        enemies.velX.resize(enemyTotal);
+        enemies.velY.resize(enemyTotal);
+        enemies.cell.resize(enemyTotal);
+        enemies.health.resize(enemyTotal);
+        enemies.id.resize(enemyTotal);
+    }
+    enemies.count = enemyTotal;
+    for (int i = 0; i < enemyTotal && r.ok; i++) {
+        enemies.x.edit(i) = r.f32();
+        enemies.y.edit(i) = r.f32();
+        enemies.speed.edit(i) = r.f32();
+        enemies.velX.edit(i) = r.f32();
+        enemies.velY.edit(i) = r.f32();
+        enemies.cell.edit(i) = r.i32();
+        enemies.health.edit(i) = r.i32();
+        enemies.id.edit(i) = r.i32();
+    }
+    return r.ok && r.pos == r.size;
+}
+
+// Occupancy grid from the towers, in slot order (the order they were built).
+// False if two towers stand on the same cell.
+static bool rebuildGrid(GameWorld& world) {
+    world.chunksX = (world.gridWidth + GRID_CHUNK_SIZE - 1) / GRID_CHUNK_SIZE;
+    world.chunksY = (world.gridHeight + GRID_CHUNK_SIZE - 1) / GRID_CHUNK_SIZE;
+    world.gridChunks.resize(world.chunksX * world.chunksY);
+    for (int c = 0; c < world.gridChunks.size(); c++) {
+        GridChunk& chunk = world.gridChunks.edit(c);
+        for (int cell = 0; cell < GRID_CHUNK_SIZE * GRID_CHUNK_SIZE; cell++) chunk.towerAt[cell] = -1;
+        chunk.towers.clear();
+    }
+
+    for (int i = 0; i < world.towers.capacity(); i++) {
+        const Tower& tower = world.towers[i];
+        if (!tower.active) continue;
+        GridChunk& chunk = chunkAt(world, tower.gridX, tower.gridY);
+        int cell = (tower.gridY % GRID_CHUNK_SIZE) * GRID_CHUNK_SIZE + tower.gridX % GRID_CHUNK_SIZE;
+        if (chunk.towerAt[cell] >= 0) return false;
+        chunk.towerAt[cell] = i;
+        chunk.towers.push_back(i);
+    }
+    return true;
+}
+
+bool readSaveState(GameWorld& world, const unsigned char* data, size_t size) {
+    if (!data || size < (size_t)SAVE_STATE_HEADER_BYTES || memcmp(data, "PDSS", 4) != 0) return false;
+
+    SaveReader header = { data, size, 4, true };
+    uint16_t version = header.u16();
+    uint32_t payloadBytes = header.u32();
+    uint32_t expected = header.u32();
+    const unsigned char* payload = data + SAVE_STATE_HEADER_BYTES;
+    if (version != SAVE_STATE_VERSION || payloadBytes != size - SAVE_STATE_HEADER_BYTES
+        || checksum(payload, payloadBytes) != expected) return false;
+
+    // Decode into a world of its own, so a save state that turns out to be
+    // broken halfway through leaves the running game as it was
+    GameWorld restored;
+    SaveReader r = { payload, payloadBytes, 0, true };
+    if (!readPayload(restored, r) || !rebuildGrid(restored)) return false;
+
+    buildFlowField(restored);   // Enemies keep the headings they were saved with
+    restored.radarStatsValid = false;
+    world = std::move(restored);
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// FILES
+// ═══════════════════════════════════════════════════════════════════════
+
+bool saveStateFile(const char* path, const GameWorld& world) {
+    std::vector<unsigned char> buffer(getSaveStateSize(world));
+    writeSaveState(world, buffer.data(), buffer.size());
+
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+    bool ok = fwrite(buffer.data(), buffer.size(), 1, file) == 1;
+    fclose(file);
+    return ok;
+}
+
+bool loadStateFile(const char* path, GameWorld& world) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+
+    // readSaveState() checks the size against the header
+    std::vector<unsigned char> buffer;
+    unsigned char block[4096];
+    size_t got;
+    while ((got = fread(block, 1, sizeof(block), file)) > 0) buffer.insert(buffer.end(), block, block + got);
+    fclose(file);
+    return readSaveState(world, buffer.data(), buffer.size());
+}
+
+void branchFromSaveState(const GameWorld& saved, GameWorld& world, uint64_t seed) {
+    forkWorld(saved, world);
+    world.gameSeed = seed;
+    seedRng(world.gameRng, seed);
+}
@@ -0,0 +1,53 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════
+ *  PLANETARY DEFENSE COMMAND - Save States
+ * ═══════════════════════════════════════════════════════════════════════
+ *  A compact binary copy of a whole GameWorld: towers, enemies,
+ *  projectiles, RNG state, timers and the economy values. Writing goes
+ *  into a buffer the caller owns (no heap allocations), and restoring it
+ *  continues the game exactly as if it had never stopped, so a lesson can
+ *  rewind to a checkpoint and a simulation can branch from one.
+ *  Everything that can be worked out again (occupancy grid, flow field,
+ *  radar cache, scratch buffers) is rebuilt instead of stored.
+ *  NOTE: This file is part of the engine - students should NOT edit this.
+ * ═══════════════════════════════════════════════════════════════════════
+ */
+
+#ifndef SAVE_STATE_H
+#define SAVE_STATE_H
+
+#include <cstddef>
+#include <cstdint>
+
+struct GameWorld;
+
+// Layout (little endian):
+//   "PDSS"  u16 version  u32 payloadBytes  u32 checksum (FNV-1a of the payload)
+//   payload: timing + RNG, game state, map and capacity, economy, status
+//   message, tower pool, projectile pool, enemies (see SaveState.cpp)
+const int SAVE_STATE_HEADER_BYTES = 14;
+
+// Bytes writeSaveState() needs for this world
+size_t getSaveStateSize(const GameWorld& world);
+
+// Write the world into buffer. Returns the bytes written, 0 if the
+// buffer is smaller than getSaveStateSize().
+size_t writeSaveState(const GameWorld& world, unsigned char* buffer, size_t capacity);
+
+// Replace the world with a saved one. A save state with a wrong header,
+// version, size or checksum, or with invalid data inside, is rejected
+// (false) and the world is left as it was.
+bool readSaveState(GameWorld& world, const unsigned char* data, size_t size);
+
+// The same as a file, e.g. the F5 checkpoint of the game for the --load
+// option of the headless and balance runners. False if the file could
+// not be written, or could not be read or restored (world untouched).
+bool saveStateFile(const char* path, const GameWorld& world);
+bool loadStateFile(const char* path, GameWorld& world);
+
+// Start a game in `world` from a restored save state: a fork of `saved`
+// (see forkWorld()) whose random stream is seeded with `seed`, so every
+// seed plays a different future from the same moment.
+void branchFromSaveState(const GameWorld& saved, GameWorld& world, uint64_t seed);
+
+#endif // SAVE_STATE_H
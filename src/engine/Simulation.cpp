@@ -0,0 +1,1181 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════
+ *  PLANETARY DEFENSE COMMAND - Simulation Core
+ * ═══════════════════════════════════════════════════════════════════════
+ *  Game state, spawning, targeting and the per-tick update.
+ *  NOTE: This file is part of the engine - students should NOT edit this.
+ *
+ *  Nothing in here may call Raylib: the headless runner links this file
+ *  without any graphics library.
+ * ═══════════════════════════════════════════════════════════════════════
+ */
+
+#include "Simulation.h"
+#include "EnemyKernels.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+// ═══════════════════════════════════════════════════════════════════════
+// DETERMINISTIC RANDOM NUMBERS (PCG32)
+// ═══════════════════════════════════════════════════════════════════════
+
+void seedRng(SimRng& rng, uint64_t seed) {
+    rng.state = 0;
+    rng.inc = (seed << 1) | 1u;   // Stream selector must be odd
+    rngNext(rng);
+    rng.state += seed;
+    rngNext(rng);
+}
+
+uint32_t rngNext(SimRng& rng) {
+    uint64_t old = rng.state;
+    rng.state = old * 6364136223846793005ULL + rng.inc;
+    uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+    uint32_t rot = (uint32_t)(old >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+}
+
+int rngRange(SimRng& rng, int n) {
+    return n > 0 ? (int)(rngNext(rng) % (uint32_t)n) : 0;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// HELPER FUNCTIONS
+// ═══════════════════════════════════════════════════════════════════════
+
+// Convert grid coordinates to the pixel centre of the cell
+SimPoint gridToWorld(int gridX, int gridY) {
+    return {
+        (float)(GRID_OFFSET_X + gridX * CELL_SIZE + CELL_SIZE / 2),
+        (float)(GRID_OFFSET_Y + gridY * CELL_SIZE + CELL_SIZE / 2)
+    };
+}
+
+// Check if grid position is valid
+bool isValidGridPos(const GameWorld& world, int gridX, int gridY) {
+    return gridX >= 0 && gridX < world.gridWidth && gridY >= 0 && gridY < world.gridHeight;
+}
+
+GridChunk& chunkAt(GameWorld& world, int gridX, int gridY) {
+    return world.gridChunks.edit((gridY / GRID_CHUNK_SIZE) * world.chunksX + gridX / GRID_CHUNK_SIZE);
+}
+
+const GridChunk& chunkAt(const GameWorld& world, int gridX, int gridY) {
+    return world.gridChunks[(gridY / GRID_CHUNK_SIZE) * world.chunksX + gridX / GRID_CHUNK_SIZE];
+}
+
+// Slot of the tower on a cell, -1 if the cell is empty or off the map
+int towerIndexAt(const GameWorld& world, int gridX, int gridY) {
+    if (!isValidGridPos(world, gridX, gridY)) return -1;
+    int cell = (gridY % GRID_CHUNK_SIZE) * GRID_CHUNK_SIZE + gridX % GRID_CHUNK_SIZE;
+    return chunkAt(world, gridX, gridY).towerAt[cell];
+}
+
+// Check if a tower exists at position
+bool hasTowerAt(const GameWorld& world, int gridX, int gridY) {
+    return towerIndexAt(world, gridX, gridY) >= 0;
+}
+
+int getBaseRow(const GameWorld& world) {
+    return world.gridHeight / 2 - 1;
+}
+
+// Five lanes around the HQ rows
+int getSpawnRow(const GameWorld& world, int waveNumber) {
+    return getBaseRow(world) - 1 + (waveNumber % SPAWN_LANES);
+}
+
+// Check if position is the base
+bool isBasePosition(const GameWorld& world, int gridX, int gridY) {
+    int baseRow = getBaseRow(world);
+    return gridX == world.gridWidth - 1 && (gridY == baseRow || gridY == baseRow + 1);
+}
+
+// Calculate distance between two points
+double calculateDistance(float x1, float y1, float x2, float y2) {
+    float dx = x2 - x1;
+    float dy = y2 - y1;
+    return sqrt(dx * dx + dy * dy);
+}
+
+// Set status message
+void setMessage(GameWorld& world, const std::string& msg) {
+    world.statusMessage = msg;
+    world.messageTimer = 3.0f;
+}
+
+// Packed cell (see packEnemyCell) of a pixel position
+static int enemyCellAt(float x, float y) {
+    return packEnemyCell(x, y, (float)GRID_OFFSET_X, (float)GRID_OFFSET_Y, (float)CELL_SIZE);
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// FLOW FIELD
+// ═══════════════════════════════════════════════════════════════════════
+// Breadth-first search outward from the HQ cells; tower cells are walls.
+// Every cell then points at a neighbour one step closer, trying right,
+// up, down and left in that order, so on an open map enemies keep to
+// their lane until they reach the HQ column.
+
+const int FLOW_STEP_X[4] = { 1, 0, 0, -1 };
+const int FLOW_STEP_Y[4] = { 0, -1, 1, 0 };
+
+// Neighbour one step closer to the HQ, -1 for HQ and unreachable cells
+int pickFlowNext(const GameWorld& world, int gridX, int gridY) {
+    int steps = world.flowDistance[gridY * world.gridWidth + gridX];
+    if (steps <= 0) return -1;
+
+    for (int k = 0; k < 4; k++) {
+        int nx = gridX + FLOW_STEP_X[k];
+        int ny = gridY + FLOW_STEP_Y[k];
+        if (isValidGridPos(world, nx, ny) && world.flowDistance[ny * world.gridWidth + nx] == steps - 1) {
+            return ny * world.gridWidth + nx;
+        }
+    }
+    return -1;
+}
+
+void buildFlowField(GameWorld& world) {
+    int cellCount = world.gridWidth * world.gridHeight;
+    world.flowDistance.assign(cellCount, -1);
+    world.flowNext.assign(cellCount, -1);
+    world.flowQueue.resize(cellCount);
+    world.flowCutMark.assign(cellCount, 0);
+    world.flowVisitMark.assign(cellCount, 0);
+    world.flowEpoch = 0;
+
+    // The HQ cells are the sources
+    int head = 0, tail = 0;
+    for (int y = 0; y < world.gridHeight; y++) {
+        if (!isBasePosition(world, world.gridWidth - 1, y)) continue;
+        int cell = y * world.gridWidth + world.gridWidth - 1;
+        world.flowDistance[cell] = 0;
+        world.flowQueue[tail++] = cell;
+    }
+
+    while (head < tail) {
+        int cell = world.flowQueue[head++];
+        int x = cell % world.gridWidth;
+        int y = cell / world.gridWidth;
+        for (int k = 0; k < 4; k++) {
+            int nx = x + FLOW_STEP_X[k];
+            int ny = y + FLOW_STEP_Y[k];
+            if (!isValidGridPos(world, nx, ny) || hasTowerAt(world, nx, ny)) continue;
+            int next = ny * world.gridWidth + nx;
+            if (world.flowDistance[next] >= 0) continue;
+            world.flowDistance[next] = world.flowDistance[cell] + 1;
+            world.flowQueue[tail++] = next;
+        }
+    }
+
+    for (int y = 0; y < world.gridHeight; y++) {
+        for (int x = 0; x < world.gridWidth; x++) {
+            world.flowNext[y * world.gridWidth + x] = pickFlowNext(world, x, y);
+        }
+    }
+}
+
+void rebuildFlowField(GameWorld& world) {
+    buildFlowField(world);
+
+    // Walking enemies follow the new field from where they are
+    for (int i = 0; i < world.enemies.count; i++) steerEnemy(world, i);
+}
+
+// Does the cell have a neighbour one step closer that keeps its path?
+bool hasFlowSupport(const GameWorld& world, int gridX, int gridY, int steps) {
+    for (int k = 0; k < 4; k++) {
+        int nx = gridX + FLOW_STEP_X[k];
+        int ny = gridY + FLOW_STEP_Y[k];
+        if (!isValidGridPos(world, nx, ny)) continue;
+        int n = ny * world.gridWidth + nx;
+        if (world.flowCutMark[n] != world.flowEpoch && world.flowDistance[n] == steps - 1) return true;
+    }
+    return false;
+}
+
+// Would the repair just done leave a spawn lane or an enemy with no path?
+bool flowRepairStrandsAnyone(const GameWorld& world, int closed) {
+    for (int lane = 0; lane < SPAWN_LANES; lane++) {
+        int cell = getSpawnRow(world, lane) * world.gridWidth;   // Column 0
+        if (cell == closed || (world.flowCutMark[cell] == world.flowEpoch && world.flowDistance[cell] < 0)) return true;
+    }
+    for (int i = 0; i < world.enemies.count; i++) {
+        int gridX = world.enemies.cell[i] & 0xFFFF;
+        int gridY = world.enemies.cell[i] >> 16;
+        if (!isValidGridPos(world, gridX, gridY)) continue;
+        int cell = gridY * world.gridWidth + gridX;
+        if (cell == closed || (world.flowCutMark[cell] == world.flowEpoch && world.flowDistance[cell] < 0)) return true;
+    }
+    return false;
+}
+
+// Dirty-region repair. Distances can only grow when a wall appears, and
+// only for cells whose every shortest path went through it:
+//  1. walk outward from the wall, level by level, and collect the cells
+//     left with no neighbour one step closer (the cut cells);
+//  2. give the cut cells new distances with a Dijkstra pass seeded from
+//     the untouched cells around them;
+//  3. pick the next step again for the cut cells and their neighbours,
+//     and re-steer the enemies standing on a cell whose step changed.
+// The result is exactly what rebuildFlowField() would give.
+bool closeFlowCell(GameWorld& world, int gridX, int gridY, bool keepPaths) {
+    if (!isValidGridPos(world, gridX, gridY)) return false;
+    int closed = gridY * world.gridWidth + gridX;
+    int closedSteps = world.flowDistance[closed];
+    if (closedSteps < 0) return true;   // Already a wall or cut off: no path goes through it
+
+    world.flowEpoch++;
+    world.flowCut.clear();
+    world.flowCutOldDistance.clear();
+    world.flowCutMark[closed] = world.flowEpoch;
+    world.flowDistance[closed] = -1;
+
+    // 1. Cut cells (FIFO = increasing distance, so every cell one step
+    //    closer has been decided before a cell is looked at)
+    int head = 0, tail = 0;
+    for (int k = 0; k < 4; k++) {
+        int nx = gridX + FLOW_STEP_X[k];
+        int ny = gridY + FLOW_STEP_Y[k];
+        if (!isValidGridPos(world, nx, ny)) continue;
+        int n = ny * world.gridWidth + nx;
+        if (world.flowDistance[n] == closedSteps + 1) {
+            world.flowVisitMark[n] = world.flowEpoch;
+            world.flowQueue[tail++] = n;
+        }
+    }
+    while (head < tail) {
+        int cell = world.flowQueue[head++];
+        int x = cell % world.gridWidth;
+        int y = cell / world.gridWidth;
+        int steps = world.flowDistance[cell];
+        if (hasFlowSupport(world, x, y, steps)) continue;
+
+        world.flowCutMark[cell] = world.flowEpoch;
+        world.flowCut.push_back(cell);
+        world.flowCutOldDistance.push_back(steps);
+        for (int k = 0; k < 4; k++) {
+            int nx = x + FLOW_STEP_X[k];
+            int ny = y + FLOW_STEP_Y[k];
+            if (!isValidGridPos(world, nx, ny)) continue;
+            int n = ny * world.gridWidth + nx;
+            if (world.flowDistance[n] == steps + 1 && world.flowVisitMark[n] != world.flowEpoch) {
+                world.flowVisitMark[n] = world.flowEpoch;
+                world.flowQueue[tail++] = n;
+            }
+        }
+    }
+
+    // 2. New distances, from the best untouched neighbour of each cut cell
+    for (int cell : world.flowCut) world.flowDistance[cell] = -1;
+    world.flowHeap.clear();
+    for (int cell : world.flowCut) {
+        int x = cell % world.gridWidth;
+        int y = cell / world.gridWidth;
+        int best = -1;
+        for (int k = 0; k < 4; k++) {
+            int nx = x + FLOW_STEP_X[k];
+            int ny = y + FLOW_STEP_Y[k];
+            if (!isValidGridPos(world, nx, ny)) continue;
+            int n = ny * world.gridWidth + nx;
+            if (world.flowCutMark[n] == world.flowEpoch || world.flowDistance[n] < 0) continue;
+            if (best < 0 || world.flowDistance[n] + 1 < best) best = world.flowDistance[n] + 1;
+        }
+        if (best < 0) continue;
+        world.flowDistance[cell] = best;
+        world.flowHeap.push_back({ best, cell });
+        std::push_heap(world.flowHeap.begin(), world.flowHeap.end(), std::greater<std::pair<int, int> >());
+    }
+    while (!world.flowHeap.empty()) {
+        std::pop_heap(world.flowHeap.begin(), world.flowHeap.end(), std::greater<std::pair<int, int> >());
+        std::pair<int, int> top = world.flowHeap.back();
+        world.flowHeap.pop_back();
+        int steps = top.first;
+        int cell = top.second;
+        if (world.flowDistance[cell] != steps) continue;   // Stale entry
+
+        int x = cell % world.gridWidth;
+        int y = cell / world.gridWidth;
+        for (int k = 0; k < 4; k++) {
+            int nx = x + FLOW_STEP_X[k];
+            int ny = y + FLOW_STEP_Y[k];
+            if (!isValidGridPos(world, nx, ny)) continue;
+            int n = ny * world.gridWidth + nx;
+            if (n == closed || world.flowCutMark[n] != world.flowEpoch) continue;
+            if (world.flowDistance[n] < 0 || steps + 1 < world.flowDistance[n]) {
+                world.flowDistance[n] = steps + 1;
+                world.flowHeap.push_back({ steps + 1, n });
+                std::push_heap(world.flowHeap.begin(), world.flowHeap.end(), std::greater<std::pair<int, int> >());
+            }
+        }
+    }
+
+    // Walled off: put the old distances back
+    if (keepPaths && flowRepairStrandsAnyone(world, closed)) {
+        for (size_t c = 0; c < world.flowCut.size(); c++) world.flowDistance[world.flowCut[c]] = world.flowCutOldDistance[c];
+        world.flowDistance[closed] = closedSteps;
+        return false;
+    }
+
+    // 3. Next steps around the repaired cells (a new mark, so flowVisitMark can be reused)
+    world.flowEpoch++;
+    world.flowCut.push_back(closed);
+    for (int cell : world.flowCut) {
+        int x = cell % world.gridWidth;
+        int y = cell / world.gridWidth;
+        for (int k = -1; k < 4; k++) {
+            int nx = (k < 0) ? x : x + FLOW_STEP_X[k];
+            int ny = (k < 0) ? y : y + FLOW_STEP_Y[k];
+            if (!isValidGridPos(world, nx, ny)) continue;
+            int n = ny * world.gridWidth + nx;
+            int next = pickFlowNext(world, nx, ny);
+            if (next != world.flowNext[n]) {
+                world.flowNext[n] = next;
+                world.flowVisitMark[n] = world.flowEpoch;
+            }
+        }
+    }
+    for (int i = 0; i < world.enemies.count; i++) {
+        int ex = world.enemies.cell[i] & 0xFFFF;
+        int ey = world.enemies.cell[i] >> 16;
+        if (isValidGridPos(world, ex, ey) && world.flowVisitMark[ey * world.gridWidth + ex] == world.flowEpoch) steerEnemy(world, i);
+    }
+    return true;
+}
+
+void steerEnemy(GameWorld& world, int index) {
+    int gridX = world.enemies.cell[index] & 0xFFFF;
+    int gridY = world.enemies.cell[index] >> 16;
+    int next = isValidGridPos(world, gridX, gridY) ? world.flowNext[gridY * world.gridWidth + gridX] : -1;
+    float speed = world.enemies.speed[index];
+
+    // No path (walled in or on a tower): straight on toward the HQ column
+    if (next < 0) {
+        world.enemies.velX.edit(index) = speed;
+        world.enemies.velY.edit(index) = 0;
+        return;
+    }
+
+    SimPoint target = gridToWorld(next % world.gridWidth, next / world.gridWidth);
+    float dx = target.x - world.enemies.x[index];
+    float dy = target.y - world.enemies.y[index];
+    float length = sqrtf(dx * dx + dy * dy);
+    world.enemies.velX.edit(index) = dx / length * speed;
+    world.enemies.velY.edit(index) = dy / length * speed;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// RADAR HELPER - Convert game enemies to Radar format
+// ═══════════════════════════════════════════════════════════════════════
+// This creates data that can be passed to student's 04_Radar.cpp functions
+
+std::vector<RadarEnemy> getRadarEnemies(const GameWorld& world) {
+    std::vector<RadarEnemy> radarList;
+    fillRadarEnemies(world, radarList);
+    return radarList;
+}
+
+void fillRadarEnemies(const GameWorld& world, std::vector<RadarEnemy>& radarList) {
+    radarList.resize(world.enemies.count);
+
+    // Base position for distance calculation
+    float baseX = GRID_OFFSET_X + (world.gridWidth - 1) * CELL_SIZE;
+
+    for (int i = 0; i < world.enemies.count; i++) {
+        RadarEnemy& re = radarList[i];
+
+        // Distance to base in grid units: along the path, straight when there is none
+        int gridX = world.enemies.cell[i] & 0xFFFF;
+        int gridY = world.enemies.cell[i] >> 16;
+        int steps = isValidGridPos(world, gridX, gridY) ? world.flowDistance[gridY * world.gridWidth + gridX] : -1;
+        re.distance = (steps >= 0) ? steps : (baseX - world.enemies.x[i]) / CELL_SIZE;
+        re.health = world.enemies.health[i];
+        re.isFlying = false;  // Regular enemies don't fly (could be expanded later!)
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// RADAR STATISTICS
+// ═══════════════════════════════════════════════════════════════════════
+
+const RadarStats& getRadarStats(GameWorld& world) {
+    if (world.radarStatsValid && world.radarStatsTick == world.simTick) return world.radarStats;
+
+    fillRadarEnemies(world, world.radarStats.enemies);
+    RadarView view(world.radarStats.enemies);
+
+    // *** CALLING STUDENT'S FUNCTIONS from 04_Radar.cpp ***
+    world.radarStats.total = countAllEnemies(view);
+    world.radarStats.close = countCloseEnemies(view, RADAR_CLOSE_DISTANCE);
+    world.radarStats.totalHealth = getTotalEnemyHealth(view);
+    world.radarStats.closest = findClosestEnemy(view);
+    world.radarStats.strongest = findStrongestEnemy(view);
+    world.radarStats.flyingInRange = countFlyingEnemiesInRange(view, RADAR_CLOSE_DISTANCE);
+    world.radarStats.firstDangerous = findFirstDangerousEnemy(view, RADAR_DANGER_HEALTH);
+
+    world.radarStatsValid = true;
+    world.radarStatsTick = world.simTick;
+    return world.radarStats;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// UPGRADE HELPER - Convert game towers to Upgrade format
+// ═══════════════════════════════════════════════════════════════════════
+// This creates data that can be passed to student's 05_Upgrades.cpp functions
+
+UpgradeTower toUpgradeTower(const GameWorld& world, const Tower& tower) {
+    UpgradeTower ut;
+    ut.level = tower.level;
+    ut.damage = world.economy.towerBaseDamage;
+    ut.range = world.economy.towerRange;
+    ut.type = tower.type;
+    ut.kills = tower.kills;
+    return ut;
+}
+
+std::vector<UpgradeTower> getUpgradeTowers(const GameWorld& world) {
+    std::vector<UpgradeTower> upgradeList;
+
+    for (int i = 0; i < world.towers.capacity(); i++) {
+        if (!world.towers[i].active) continue;
+        upgradeList.push_back(toUpgradeTower(world, world.towers[i]));
+    }
+    return upgradeList;
+}
+
+UpgradePlayer getUpgradePlayer(const GameWorld& world) {
+    UpgradePlayer up;
+    up.name = world.economy.commanderName;
+    up.money = world.playerMoney;
+    up.totalKills = world.totalPlayerKills;
+    up.wavesCompleted = world.wave - 1;
+    up.isPremium = false;  // Could be toggled with a key!
+    return up;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// GAME INITIALIZATION
+// ═══════════════════════════════════════════════════════════════════════
+
+void reloadEconomyConfig(GameWorld& world) {
+    // *** CALLING STUDENT'S FUNCTIONS from 01_Economy.cpp ***
+    world.economy.startingMoney = getStartingMoney();
+    world.economy.baseHealth = getBaseHealth();
+    world.economy.commanderName = getCommanderName();
+    world.economy.towerCost = getTowerCost();
+    world.economy.towerBaseDamage = getTowerBaseDamage();
+    world.economy.towerRange = getTowerRange();
+    world.economy.killBonus = getKillBonus();
+}
+
+void setGridSize(GameWorld& world, int width, int height) {
+    world.gridWidth = width < MIN_GRID_SIZE ? MIN_GRID_SIZE : width > MAX_GRID_SIZE ? MAX_GRID_SIZE : width;
+    world.gridHeight = height < MIN_GRID_SIZE ? MIN_GRID_SIZE : height > MAX_GRID_SIZE ? MAX_GRID_SIZE : height;
+}
+
+void setCapacity(GameWorld& world, int towerSlots, int enemySlots) {
+    world.maxTowers = towerSlots < 1 ? 1 : towerSlots > MAX_TOWERS_LIMIT ? MAX_TOWERS_LIMIT : towerSlots;
+    world.maxEnemies = enemySlots < 1 ? 1 : enemySlots > MAX_ENEMIES_LIMIT ? MAX_ENEMIES_LIMIT : enemySlots;
+}
+
+void initGame(GameWorld& world, uint64_t seed) {
+    // Same seed + same inputs = same game
+    world.gameSeed = seed;
+    seedRng(world.gameRng, seed);
+    world.simTick = 0;
+    world.simAccumulator = 0;
+    world.radarStatsValid = false;
+    world.policyUpgradeMoney = -1;
+
+    // *** CALLING STUDENT'S FUNCTIONS from 01_Economy.cpp ***
+    // These values come from the student's code!
+    reloadEconomyConfig(world);
+    world.playerMoney = world.economy.startingMoney;
+    world.baseHealth = world.economy.baseHealth;
+
+    world.score = 0;
+    world.wave = 1;
+    world.towerCount = 0;
+    world.enemyCount = 0;
+    world.enemySpawnTimer = 2.0f;
+    world.gameOver = false;
+    world.gamePaused = false;
+
+    // Clear towers (slots are added again as towers are built)
+    world.towers.reset(TOWER_POOL_GROW < world.maxTowers ? TOWER_POOL_GROW : world.maxTowers, TOWER_POOL_GROW, world.maxTowers);
+    for (int i = 0; i < world.towers.capacity(); i++) {
+        Tower& tower = world.towers.edit(i);
+        tower.active = false;
+        tower.kills = 0;
+        tower.level = 1;
+        tower.type = "laser";
+    }
+
+    // Empty map, split into chunks
+    world.chunksX = (world.gridWidth + GRID_CHUNK_SIZE - 1) / GRID_CHUNK_SIZE;
+    world.chunksY = (world.gridHeight + GRID_CHUNK_SIZE - 1) / GRID_CHUNK_SIZE;
+    GridChunk emptyChunk;
+    for (int cell = 0; cell < GRID_CHUNK_SIZE * GRID_CHUNK_SIZE; cell++) {
+        emptyChunk.towerAt[cell] = -1;
+    }
+    world.gridChunks.assign(world.chunksX * world.chunksY, emptyChunk);
+
+    // Reset total kills
+    world.totalPlayerKills = 0;
+
+    // Clear enemies
+    world.enemies.count = 0;
+    world.nextEnemyId = 0;
+
+    // Paths across the empty map
+    rebuildFlowField(world);
+
+    // Clear projectiles (the pool keeps the slots it grew to)
+    if (world.projectiles.capacity() == 0) {
+        world.projectiles.reset(PROJECTILE_POOL_START, PROJECTILE_POOL_GROW);
+    }
+    world.projectiles.clear();
+    for (int i = 0; i < world.projectiles.capacity(); i++) {
+        world.projectiles.edit(i).active = false;
+    }
+
+    // *** STUDENT'S FUNCTION: getCommanderName() ***
+    setMessage(world, "Welcome, " + world.economy.commanderName + "! Click to place towers.");
+}
+
+// Append an enemy to the packed store
+int addEnemy(GameWorld& world, float x, float y, int health, float speed) {
+    if (world.enemies.count >= world.maxEnemies) return -1;
+
+    if (world.enemies.count == (int)world.enemies.x.size()) {
+        int grown = world.enemies.count < 16 ? 16 : world.enemies.count * 2;
+        if (grown > world.maxEnemies) grown = world.maxEnemies;
+        world.enemies.x.resize(grown);
+        world.enemies.y.resize(grown);
+        world.enemies.speed.resize(grown);
+        world.enemies.velX.resize(grown);
+        world.enemies.velY.resize(grown);
+        world.enemies.cell.resize(grown);
+        world.enemies.health.resize(grown);
+        world.enemies.id.resize(grown);
+    }
+
+    int i = world.enemies.count++;
+    world.enemies.x.edit(i) = x;
+    world.enemies.y.edit(i) = y;
+    world.enemies.health.edit(i) = health;
+    world.enemies.speed.edit(i) = speed;
+    world.enemies.id.edit(i) = world.nextEnemyId++;
+    world.enemies.cell.edit(i) = enemyCellAt(x, y);
+    steerEnemy(world, i);
+    return i;
+}
+
+// Remove an enemy by moving the last one into its slot
+void removeEnemyAt(GameWorld& world, int index) {
+    int last = --world.enemies.count;
+    if (index == last) return;
+
+    world.enemies.x.edit(index) = world.enemies.x[last];
+    world.enemies.y.edit(index) = world.enemies.y[last];
+    world.enemies.health.edit(index) = world.enemies.health[last];
+    world.enemies.speed.edit(index) = world.enemies.speed[last];
+    world.enemies.velX.edit(index) = world.enemies.velX[last];
+    world.enemies.velY.edit(index) = world.enemies.velY[last];
+    world.enemies.cell.edit(index) = world.enemies.cell[last];
+    world.enemies.id.edit(index) = world.enemies.id[last];
+}
+
+// Spawn a new enemy
+void spawnEnemy(GameWorld& world) {
+    float x = (float)GRID_OFFSET_X;
+    int lane = getSpawnRow(world, world.wave);
+    float y = (float)(GRID_OFFSET_Y + lane * CELL_SIZE + CELL_SIZE / 2);
+    if (addEnemy(world, x, y, 50 + world.wave * 10, 30.0f + world.wave * 2.0f) >= 0) {
+        world.enemyCount++;
+    }
+}
+
+// Fire a projectile from tower to enemy
+void fireProjectile(GameWorld& world, float fromX, float fromY, float toX, float toY) {
+    int i = world.projectiles.allocate();
+    if (i < 0) return;
+
+    Projectile& shot = world.projectiles.edit(i);
+    shot.x = fromX;
+    shot.y = fromY;
+    shot.targetX = toX;
+    shot.targetY = toY;
+    shot.speed = 500.0f;
+    shot.active = true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// ENEMY BUCKET INDEX - Which enemies are in which part of the grid
+// ═══════════════════════════════════════════════════════════════════════
+// Rebuilt once per tick (counting sort by bucket), so a tower only looks
+// at the buckets its range touches instead of every enemy slot.
+// A bucket is a square of cells, one cell on small or crowded maps and
+// bigger on large, sparse ones, so the rebuild never has to clear many
+// more buckets than there are enemies. Enemies of one bucket are stored
+// in increasing slot order.
+
+const int MIN_BUCKETS = 4096;    // Buckets are allowed regardless of enemy count
+
+void rebuildEnemyBuckets(GameWorld& world) {
+    if ((int)world.bucketEnemies.size() < world.enemies.count) {
+        world.bucketEnemies.resize(world.enemies.count);
+        world.enemyBucket.resize(world.enemies.count);
+        world.enemyCellX.resize(world.enemies.count);
+        world.enemyCellY.resize(world.enemies.count);
+    }
+
+    // Smallest buckets that keep the bucket count near the enemy count
+    int maxBuckets = 4 * world.enemies.count > MIN_BUCKETS ? 4 * world.enemies.count : MIN_BUCKETS;
+    world.bucketShift = 0;
+    while (world.bucketShift < 4) {
+        int side = 1 << world.bucketShift;
+        int count = ((world.gridWidth + side - 1) / side) * ((world.gridHeight + side - 1) / side);
+        if (count <= maxBuckets) break;
+        world.bucketShift++;
+    }
+    world.bucketsX = ((world.gridWidth - 1) >> world.bucketShift) + 1;
+    int bucketCount = world.bucketsX * (((world.gridHeight - 1) >> world.bucketShift) + 1);
+    world.bucketStart.assign(bucketCount + 1, 0);
+
+    // Count enemies per bucket (cells clamped onto the grid)
+    for (int i = 0; i < world.enemies.count; i++) {
+        int cx = (int)((world.enemies.x[i] - GRID_OFFSET_X) / CELL_SIZE);
+        int cy = (int)((world.enemies.y[i] - GRID_OFFSET_Y) / CELL_SIZE);
+        if (cx < 0) cx = 0; else if (cx >= world.gridWidth) cx = world.gridWidth - 1;
+        if (cy < 0) cy = 0; else if (cy >= world.gridHeight) cy = world.gridHeight - 1;
+        world.enemyCellX[i] = (short)cx;
+        world.enemyCellY[i] = (short)cy;
+        world.enemyBucket[i] = (cy >> world.bucketShift) * world.bucketsX + (cx >> world.bucketShift);
+        world.bucketStart[world.enemyBucket[i] + 1]++;
+    }
+
+    // Prefix sum -> start offset of every bucket
+    for (int b = 0; b < bucketCount; b++) world.bucketStart[b + 1] += world.bucketStart[b];
+
+    // Scatter (slot order is kept inside each bucket)
+    world.bucketFill.assign(world.bucketStart.begin(), world.bucketStart.end() - 1);
+    for (int i = 0; i < world.enemies.count; i++) {
+        world.bucketEnemies[world.bucketFill[world.enemyBucket[i]]++] = i;
+    }
+}
+
+// Collect up to maxFound live enemies (lowest slots first) from the cells
+// within `range` grid units of a tower. Returns how many were found.
+int findEnemiesNearTower(const GameWorld& world, int towerX, int towerY, double range, int* found, int maxFound) {
+    // An enemy within range of the cell centre can be at most this many cells away
+    int reach = (int)ceil(range + 0.5);
+    int maxReach = world.gridWidth > world.gridHeight ? world.gridWidth : world.gridHeight;
+    if (reach > maxReach) reach = maxReach;
+
+    int minX = towerX - reach < 0 ? 0 : towerX - reach;
+    int maxX = towerX + reach >= world.gridWidth ? world.gridWidth - 1 : towerX + reach;
+    int minY = towerY - reach < 0 ? 0 : towerY - reach;
+    int maxY = towerY + reach >= world.gridHeight ? world.gridHeight - 1 : towerY + reach;
+
+    // Plain pointers: writes to found[] cannot make the compiler reload them
+    const int* start = world.bucketStart.data();
+    const int* slots = world.bucketEnemies.data();
+    const short* cellX = world.enemyCellX.data();
+    const short* cellY = world.enemyCellY.data();
+    const CowArray<int, ENEMY_CHUNK_SIZE>& health = world.enemies.health;
+    bool wholeBuckets = (world.bucketShift == 0);   // One-cell buckets need no edge test
+
+    int count = 0;
+    for (int by = minY >> world.bucketShift; by <= maxY >> world.bucketShift; by++) {
+        for (int bx = minX >> world.bucketShift; bx <= maxX >> world.bucketShift; bx++) {
+            int b = by * world.bucketsX + bx;
+            for (int j = start[b]; j < start[b + 1]; j++) {
+                int e = slots[j];
+                if (!wholeBuckets && (cellX[e] < minX || cellX[e] > maxX || cellY[e] < minY || cellY[e] > maxY)) continue;
+
+                // Keep the lowest slot indices (same order as a full scan);
+                // the rest of the bucket only holds higher ones
+                if (count == maxFound && e > found[count - 1]) break;
+                if (health[e] <= 0) continue;  // Killed earlier this tick
+
+                int pos = (count < maxFound) ? count++ : count - 1;
+                while (pos > 0 && found[pos - 1] > e) {
+                    found[pos] = found[pos - 1];
+                    pos--;
+                }
+                found[pos] = e;
+            }
+        }
+    }
+    return count;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// TOWER TARGETING
+// ═══════════════════════════════════════════════════════════════════════
+// Phase 1 runs on every core: each tower that is off cooldown picks a
+// target from the enemies as they were at the start of the tower phase.
+// It only reads the world and writes its own decision, so the order the
+// jobs run in does not matter (and no job copies a shared tower chunk,
+// see Cow.h). The student functions it calls run on several threads at
+// once; that is only safe because GameEngine.h asks for pure functions.
+// Phase 2 (in updateGame) walks the towers in slot order, counts down
+// the cooldowns and applies the shots: critical-hit dice, damage, kills
+// and money. A tower whose nearby
+// enemies were killed by an earlier tower chooses again there, so the game
+// is the same as a serial loop for any thread count.
+
+const int TOWER_JOB_GRAIN = 32;   // Towers per job (small maps stay on one thread)
+
+// Pick the target of a ready tower from the enemies still alive
+void chooseTowerTarget(const GameWorld& world, int t, TowerDecision& decision) {
+    SimPoint towerPos = gridToWorld(world.towers[t].gridX, world.towers[t].gridY);
+
+    // *** STUDENT'S FUNCTION: getTowerRange() from 01_Economy.cpp ***
+    double towerRange = world.economy.towerRange;
+
+    // *** CALLING STUDENT'S FUNCTION: calculateGridDistance() from 03_Targeting.cpp ***
+    // Find up to 3 nearby enemies (from the bucket index) and their distances for selectTarget()
+    double enemyDist[3] = { 9999, 9999, 9999 };
+    decision.nearbyCount = findEnemiesNearTower(world, world.towers[t].gridX, world.towers[t].gridY, towerRange, decision.nearby, 3);
+    decision.target = -1;
+    decision.inRange = false;
+
+    for (int n = 0; n < decision.nearbyCount; n++) {
+        int e = decision.nearby[n];
+
+        // Use student's calculateGridDistance for pixel-to-grid conversion
+        double gridDist = calculateGridDistance(
+            world.towers[t].gridX, world.towers[t].gridY,
+            (int)((world.enemies.x[e] - GRID_OFFSET_X) / CELL_SIZE),
+            (int)((world.enemies.y[e] - GRID_OFFSET_Y) / CELL_SIZE)
+        );
+
+        // Fallback if student hasn't implemented it yet
+        if (gridDist == 0.0) {
+            double dx = towerPos.x - world.enemies.x[e];
+            double dy = towerPos.y - world.enemies.y[e];
+            gridDist = sqrt(dx*dx + dy*dy) / CELL_SIZE;
+        }
+        enemyDist[n] = gridDist;
+    }
+
+    if (decision.nearbyCount == 0) return;  // No enemies
+
+    // *** CALLING STUDENT'S FUNCTION: selectTarget() from 03_Targeting.cpp ***
+    int targetNum = selectTarget(enemyDist[0], enemyDist[1], enemyDist[2]);
+    int pick = (targetNum == 1) ? 0 : (targetNum == 2) ? 1 : 2;
+    int targetIdx = (pick < decision.nearbyCount) ? decision.nearby[pick] : -1;
+    if (targetIdx < 0) targetIdx = decision.nearby[0];  // Fallback
+
+    decision.target = targetIdx;
+    decision.distance = calculateDistance(towerPos.x, towerPos.y, world.enemies.x[targetIdx], world.enemies.y[targetIdx]);
+
+    // *** CALLING STUDENT'S FUNCTION: isEnemyInRange() from 03_Targeting.cpp ***
+    decision.inRange = isEnemyInRange(decision.distance / CELL_SIZE, towerRange);
+}
+
+// Phase 1 for one tower slot
+void decideTowerTarget(const GameWorld& world, int t, TowerDecision& decision) {
+    decision.coolingDown = false;
+    decision.ready = false;
+    if (!world.towers[t].active) return;
+
+    // *** CALLING STUDENT'S FUNCTION: calculateFireRate() from 03_Targeting.cpp ***
+    // Fire rate based on upgrade level (simulated as tower index for variety)
+    int upgradeLevel = t % 3;  // 0, 1, or 2
+    int fireRateMs = calculateFireRate(500, upgradeLevel);  // Base 500ms
+    decision.cooldownTime = fireRateMs / 1000.0f;  // Convert to seconds
+
+    // Cooldown (counted down in phase 2)
+    if (world.towers[t].cooldown > 0) {
+        decision.coolingDown = true;
+        return;
+    }
+
+    decision.ready = true;
+    chooseTowerTarget(world, t, decision);
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// GAME UPDATE
+// ═══════════════════════════════════════════════════════════════════════
+
+void updateGame(GameWorld& world, float deltaTime) {
+    if (world.gamePaused || world.gameOver) return;
+
+    // Update message timer
+    if (world.messageTimer > 0) {
+        world.messageTimer -= deltaTime;
+    }
+
+    // Spawn enemies
+    world.enemySpawnTimer -= deltaTime;
+    if (world.enemySpawnTimer <= 0) {
+        spawnEnemy(world);
+        world.enemySpawnTimer = 3.0f - (world.wave * 0.1f);  // Faster spawns each wave
+        if (world.enemySpawnTimer < 1.0f) world.enemySpawnTimer = 1.0f;
+    }
+
+    // Move enemies along their headings (SIMD kernel) and find the ones that entered a new cell
+    std::vector<int>& moved = world.movedEnemies;
+    std::vector<int>& breached = world.breachedEnemies;
+    if ((int)moved.size() < world.enemies.count) {
+        moved.resize(world.enemies.count);
+        breached.resize(world.enemies.count);
+    }
+    // One kernel call per chunk of the enemy arrays (see EnemyStore)
+    int movedCount = 0;
+    for (int base = 0; base < world.enemies.count; base += ENEMY_CHUNK_SIZE) {
+        int c = base / ENEMY_CHUNK_SIZE;
+        int count = world.enemies.count - base < ENEMY_CHUNK_SIZE ? world.enemies.count - base : ENEMY_CHUNK_SIZE;
+        int found = moveEnemiesAndFindCellChanges(world.enemies.x.editChunk(c), world.enemies.y.editChunk(c),
+                                                  world.enemies.velX.chunkData(c), world.enemies.velY.chunkData(c),
+                                                  world.enemies.cell.chunkData(c), count, deltaTime,
+                                                  (float)GRID_OFFSET_X, (float)GRID_OFFSET_Y,
+                                                  (float)CELL_SIZE, moved.data() + movedCount);
+        for (int m = movedCount; m < movedCount + found; m++) moved[m] += base;
+        movedCount += found;
+    }
+
+    // Reaching an HQ cell (or running off the map past it) is a breach,
+    // anything else takes the next step of the flow field
+    int breachCount = 0;
+    for (int m = 0; m < movedCount; m++) {
+        int i = moved[m];
+        world.enemies.cell.edit(i) = enemyCellAt(world.enemies.x[i], world.enemies.y[i]);
+        int gridX = world.enemies.cell[i] & 0xFFFF;
+        int gridY = world.enemies.cell[i] >> 16;
+        if (gridX >= world.gridWidth || isBasePosition(world, gridX, gridY)) {
+            breached[breachCount++] = i;
+        } else {
+            steerEnemy(world, i);
+        }
+    }
+
+    // Remove from the back so swap-remove never moves an unvisited breach
+    for (int b = breachCount - 1; b >= 0; b--) {
+        removeEnemyAt(world, breached[b]);
+        world.enemyCount--;
+        world.baseHealth -= 20;
+        setMessage(world, "ALERT: Enemy breached defenses! -20 HP");
+
+        if (world.baseHealth <= 0) {
+            world.gameOver = true;
+            setMessage(world, "GAME OVER - Base Destroyed!");
+        }
+    }
+
+    // Index surviving enemies by grid cell for the tower range queries
+    rebuildEnemyBuckets(world);
+
+    // Update towers in two phases (see TOWER TARGETING): every tower picks
+    // its target in parallel, then shots are applied one tower at a time
+    if ((int)world.towerDecisions.size() < world.towers.capacity()) world.towerDecisions.resize(world.towers.capacity());
+    parallelFor(world.towers.capacity(), TOWER_JOB_GRAIN, [&world](int begin, int end) {
+        for (int t = begin; t < end; t++) decideTowerTarget(world, t, world.towerDecisions[t]);
+    });
+
+    for (int t = 0; t < world.towers.capacity(); t++) {
+        TowerDecision& decision = world.towerDecisions[t];
+        if (decision.coolingDown) world.towers.edit(t).cooldown -= deltaTime;
+        if (!decision.ready) continue;
+
+        // A tower earlier in this loop killed one of the enemies it looked
+        // at: choose again, exactly as a fully serial loop would have
+        for (int n = 0; n < decision.nearbyCount; n++) {
+            if (world.enemies.health[decision.nearby[n]] <= 0) {
+                chooseTowerTarget(world, t, decision);
+                break;
+            }
+        }
+
+        int targetIdx = decision.target;
+        if (targetIdx < 0 || !decision.inRange) continue;
+
+        SimPoint towerPos = gridToWorld(world.towers[t].gridX, world.towers[t].gridY);
+        double dist = decision.distance;
+
+        // *** CALLING STUDENT'S FUNCTIONS from 01_Economy.cpp and 03_Targeting.cpp ***
+        int baseDamage = world.economy.towerBaseDamage;
+        int damage = calculateDamage(baseDamage, TOWER_LEVEL);
+
+        // *** CALLING STUDENT'S FUNCTION: calculateBonusDamage() from 03_Targeting.cpp ***
+        // Extra damage for weak enemies!
+        int bonusDmg = calculateBonusDamage(baseDamage, world.enemies.health[targetIdx], TOWER_LEVEL);
+        if (bonusDmg > damage) damage = bonusDmg;  // Use bonus if student implemented it
+
+        // *** CALLING STUDENT'S FUNCTION: calculateTotalDamage() from 03_Targeting.cpp ***
+        // Random critical hit (1 in 5 chance)
+        int critMultiplier = (rngRange(world.gameRng, 5) == 0) ? 2 : 1;
+        int totalDmg = calculateTotalDamage(baseDamage, TOWER_LEVEL, critMultiplier);
+        if (totalDmg > 0 && critMultiplier == 2) {
+            damage = totalDmg;  // Use crit damage if student implemented it
+        }
+
+        // *** CALLING STUDENT'S FUNCTION: predictEnemyPosition() from 03_Targeting.cpp ***
+        // Lead the shot! Predict where enemy will be (x and y separately, enemies can turn)
+        float projectileTime = dist / 500.0f;  // Time for projectile to reach
+        double predictedX = predictEnemyPosition(world.enemies.x[targetIdx], world.enemies.velX[targetIdx], projectileTime);
+        double predictedY = predictEnemyPosition(world.enemies.y[targetIdx], world.enemies.velY[targetIdx], projectileTime);
+
+        // Fire projectile (use predicted position if student implemented it, otherwise current)
+        float targetX = (predictedX != world.enemies.x[targetIdx]) ? (float)predictedX : world.enemies.x[targetIdx];
+        float targetY = (predictedY != world.enemies.y[targetIdx]) ? (float)predictedY : world.enemies.y[targetIdx];
+        fireProjectile(world, towerPos.x, towerPos.y, targetX, targetY);
+
+        // Apply damage
+        world.enemies.health.edit(targetIdx) -= damage;
+
+        if (world.enemies.health[targetIdx] <= 0) {
+            world.enemyCount--;
+            world.score += 50;
+
+            // *** Track kills for upgrade system ***
+            world.towers.edit(t).kills++;
+            world.totalPlayerKills++;
+
+            // *** STUDENT'S FUNCTION: getKillBonus() from 01_Economy.cpp ***
+            world.playerMoney += world.economy.killBonus;
+
+            // Check for wave completion
+            if (world.enemyCount <= 0) {
+                world.wave++;
+                // *** CALLING STUDENT'S FUNCTION: getWaveBonus() from 01_Economy.cpp ***
+                world.playerMoney += getWaveBonus(world.wave);
+                setMessage(world, "Wave " + std::to_string(world.wave) + " incoming! Bonus: $" + std::to_string(getWaveBonus(world.wave)));
+            }
+        }
+
+        world.towers.edit(t).cooldown = decision.cooldownTime;  // Use calculated fire rate!
+        // Don't break - tower has done its job for this frame
+    }
+
+    // Drop enemies killed this tick (back to front, see breach removal)
+    for (int i = world.enemies.count - 1; i >= 0; i--) {
+        if (world.enemies.health[i] <= 0) removeEnemyAt(world, i);
+    }
+
+    // Update projectiles
+    for (int i = 0; i < world.projectiles.capacity(); i++) {
+        if (!world.projectiles[i].active) continue;
+
+        Projectile& shot = world.projectiles.edit(i);
+        float dx = shot.targetX - shot.x;
+        float dy = shot.targetY - shot.y;
+        float dist = sqrt(dx * dx + dy * dy);
+
+        if (dist < 10) {
+            shot.active = false;
+            world.projectiles.release(i);
+        } else {
+            shot.x += (dx / dist) * shot.speed * deltaTime;
+            shot.y += (dy / dist) * shot.speed * deltaTime;
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// FIXED TIMESTEP
+// ═══════════════════════════════════════════════════════════════════════
+
+void stepSimulation(GameWorld& world) {
+    if (world.gamePaused || world.gameOver) return;  // Frozen games do not count ticks
+
+    updateGame(world, SIM_TICK_SECONDS);
+    world.simTick++;
+}
+
+int advanceSimulation(GameWorld& world, float frameSeconds) {
+    if (world.gamePaused || world.gameOver) {
+        world.simAccumulator = 0;  // Do not fast-forward after unpausing
+        return 0;
+    }
+
+    world.simAccumulator += frameSeconds * world.gameSpeed;
+
+    int ticks = 0;
+    while (world.simAccumulator >= SIM_TICK_SECONDS && ticks < SIM_MAX_CATCHUP_TICKS) {
+        stepSimulation(world);
+        world.simAccumulator -= SIM_TICK_SECONDS;
+        ticks++;
+    }
+
+    // After a long hitch, skip the time we could not catch up on
+    if (ticks == SIM_MAX_CATCHUP_TICKS && world.simAccumulator >= SIM_TICK_SECONDS) {
+        world.simAccumulator = 0;
+    }
+    return ticks;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// FORKED WORLDS
+// ═══════════════════════════════════════════════════════════════════════
+// A fork is a plain copy of the whole world. Copying a Pool, EnemyStore
+// or CowArray only copies chunk pointers, and assigning a vector reuses
+// the branch's memory, so forking into the same branch again and again
+// allocates nothing once it has the size.
+
+void forkWorld(const GameWorld& world, GameWorld& branch) {
+    branch = world;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// PLAYER ACTIONS
+// ═══════════════════════════════════════════════════════════════════════
+
+// Put a new tower on the lowest free slot
+int placeTower(GameWorld& world, int gridX, int gridY, const std::string& type) {
+    if (!isValidGridPos(world, gridX, gridY)) return -1;
+    int i = world.towers.allocate();
+    if (i < 0) return -1;
+
+    Tower& tower = world.towers.edit(i);
+    tower.gridX = gridX;
+    tower.gridY = gridY;
+    tower.cooldown = 0;
+    tower.active = true;
+    tower.kills = 0;
+    tower.level = 1;
+    tower.type = type;
+    world.towerCount++;
+
+    GridChunk& chunk = chunkAt(world, gridX, gridY);
+    chunk.towerAt[(gridY % GRID_CHUNK_SIZE) * GRID_CHUNK_SIZE + gridX % GRID_CHUNK_SIZE] = i;
+    chunk.towers.push_back(i);
+
+    // The new tower is a wall: enemies path around it
+    closeFlowCell(world, gridX, gridY, false);
+    return i;
+}
+
+// Try to build a tower on an empty cell (base / occupied cells are rejected)
+BuildResult buildTowerAt(GameWorld& world, int gridX, int gridY) {
+    if (world.gameOver || !isValidGridPos(world, gridX, gridY)) return BUILD_BAD_CELL;
+
+    // Check if position is valid (not base, not occupied)
+    if (isBasePosition(world, gridX, gridY)) {
+        setMessage(world, "Cannot build on the base!");
+        return BUILD_BAD_CELL;
+    }
+    if (hasTowerAt(world, gridX, gridY)) {
+        setMessage(world, "Position occupied!");
+        return BUILD_BAD_CELL;
+    }
+
+    // *** CALLING STUDENT'S FUNCTIONS from 01_Economy.cpp and 02_Shop.cpp ***
+    int towerCost = world.economy.towerCost;
+    bool canBuy = canAffordTower(world.playerMoney, towerCost);
+    bool cellEmpty = !hasTowerAt(world, gridX, gridY);
+
+    // *** CALLING STUDENT'S FUNCTION: canBuildTowerAt() from 02_Shop.cpp ***
+    bool canBuild = canBuildTowerAt(gridX, gridY, cellEmpty);
+    (void)canBuild;
+
+    // *** CALLING STUDENT'S FUNCTION: shouldShowWarning() from 02_Shop.cpp ***
+    bool showWarn = shouldShowWarning(canBuy, world.towerCount < world.maxTowers);
+
+    if (canBuy && world.towerCount < world.maxTowers) {
+        // *** CALLING STUDENT'S FUNCTION: recommendTower() from 05_Upgrades.cpp ***
+        bool hasAirEnemies = false;  // Could be expanded for flying enemies!
+        std::string recType = recommendTower(world.playerMoney, hasAirEnemies, world.wave);
+
+        // Never wall the enemies off from the HQ (a no-op for placeTower() afterwards)
+        if (!closeFlowCell(world, gridX, gridY, true)) {
+            setMessage(world, "Cannot build there - it would block the enemy path!");
+            return BUILD_BLOCKS_PATH;
+        }
+
+        // Place tower
+        int i = placeTower(world, gridX, gridY, (recType == "none") ? "laser" : recType);
+        if (i >= 0) {
+            world.playerMoney -= towerCost;
+
+            // *** CALLING STUDENT'S FUNCTION: getTowerType() from 02_Shop.cpp ***
+            int tType = getTowerType(world.playerMoney);
+            std::string typeStr = (tType == 3) ? "SUPER" : (tType == 2) ? "ADVANCED" : (tType == 1) ? "BASIC" : "NONE";
+            setMessage(world, "Tower (" + world.towers[i].type + ") deployed! Next: " + typeStr);
+            return BUILD_OK;
+        }
+
+        // No slot for the tower after all: take its wall down again
+        rebuildFlowField(world);
+        setMessage(world, "No free tower slots!");
+    } else if (showWarn) {
+        // Warning from student's function!
+        setMessage(world, "WARNING: Not enough credits or no slots!");
+    } else {
+        setMessage(world, "Not enough credits! Need $" + std::to_string(towerCost));
+    }
+    return BUILD_NOT_ALLOWED;
+}
+
+// Upgrade a single tower (UPGRADE button or right-click)
+bool upgradeTower(GameWorld& world, int towerIndex) {
+    if (world.gameOver || towerIndex < 0 || towerIndex >= world.towers.capacity() || !world.towers[towerIndex].active) return false;
+
+    Tower& tower = world.towers.edit(towerIndex);
+    UpgradeTower ut = toUpgradeTower(world, tower);
+
+    // *** CALLING STUDENT'S FUNCTION: canUpgrade() from 05_Upgrades.cpp ***
+    if (canUpgrade(ut, world.playerMoney)) {
+        // *** CALLING STUDENT'S FUNCTION: getUpgradeCost() from 05_Upgrades.cpp ***
+        int cost = getUpgradeCost(ut);
+        world.playerMoney -= cost;
+        tower.level++;
+
+        // *** CALLING STUDENT'S FUNCTIONS: getUpgradedDamage/Range() ***
+        int newDmg = getUpgradedDamage(ut);
+        double newRange = getUpgradedRange(ut);
+        (void)newRange;
+
+        setMessage(world, tower.type + " upgraded to Lv" + std::to_string(tower.level) + "! DMG: " + std::to_string(newDmg));
+        return true;
+    }
+
+    // *** CALLING STUDENT'S FUNCTION: getUpgradeCost() from 05_Upgrades.cpp ***
+    int cost = getUpgradeCost(ut);
+    if (tower.level >= 5) {
+        setMessage(world, "Tower already at MAX LEVEL!");
+    } else {
+        setMessage(world, "Need $" + std::to_string(cost) + " to upgrade (solve exercises!)");
+    }
+    return false;
+}
+
+// Upgrade every tower the budget allows ([U] key / AUTO-UPG button)
+int autoUpgradeTowers(GameWorld& world) {
+    if (world.gameOver) return 0;
+
+    // Build upgrade tower list from current towers
+    std::vector<UpgradeTower> upgradeList = getUpgradeTowers(world);
+
+    // *** CALLING STUDENT'S FUNCTION: autoUpgradeAll() from 05_Upgrades.cpp ***
+    int originalMoney = world.playerMoney;
+    int remainingMoney = autoUpgradeAll(upgradeList, world.playerMoney);
+    int spent = originalMoney - remainingMoney;
+
+    // Apply upgrades back to actual towers
+    int upgradeIdx = 0;
+    int upgradesApplied = 0;
+    for (int i = 0; i < world.towers.capacity() && upgradeIdx < (int)upgradeList.size(); i++) {
+        if (!world.towers[i].active) continue;
+        if (upgradeList[upgradeIdx].level > world.towers[i].level) {
+            world.towers.edit(i).level = upgradeList[upgradeIdx].level;
+            upgradesApplied++;
+        }
+        upgradeIdx++;
+    }
+
+    world.playerMoney = remainingMoney;
+
+    if (upgradesApplied > 0) {
+        setMessage(world, "AUTO-UPGRADE: " + std::to_string(upgradesApplied) + " towers upgraded! Spent $" + std::to_string(spent));
+    } else if (spent == 0) {
+        setMessage(world, "AUTO-UPGRADE: No upgrades possible (solve exercises first!)");
+    }
+    return upgradesApplied;
+}
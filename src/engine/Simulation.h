@@ -0,0 +1,381 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════
+ *  PLANETARY DEFENSE COMMAND - Simulation Core
+ * ═══════════════════════════════════════════════════════════════════════
+ *  Game state and the per-tick update, with NO dependency on Raylib.
+ *  The graphical engine (main.cpp), the headless runner (headless.cpp)
+ *  and the balance runner (balance.cpp) all drive the game through this
+ *  file. Every game lives in its own GameWorld, so several games can run
+ *  at the same time (one per thread).
+ *  NOTE: This file is part of the engine - students should NOT edit this.
+ * ═══════════════════════════════════════════════════════════════════════
+ */
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "GameEngine.h"
+#include "Cow.h"
+#include "Pool.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ═══════════════════════════════════════════════════════════════════════
+// GAME CONSTANTS
+// ═══════════════════════════════════════════════════════════════════════
+const int CELL_SIZE = 50;         // World units (pixels at zoom 1) per cell
+const int GRID_OFFSET_X = 50;     // World position of cell (0, 0)
+const int GRID_OFFSET_Y = 100;
+
+const int TOWER_COST = 100;
+const double TOWER_RANGE = 3.0;
+const int TOWER_BASE_DAMAGE = 10;
+const int TOWER_LEVEL = 1;
+
+// The simulation always advances in steps of exactly this size, whatever
+// the render frame rate is, so the same seed + inputs give the same game.
+const float SIM_TICK_SECONDS = 1.0f / 60.0f;
+const int SIM_MAX_CATCHUP_TICKS = 15;   // Drop time after a long hitch
+
+// ═══════════════════════════════════════════════════════════════════════
+// DETERMINISTIC RANDOM NUMBERS (PCG32)
+// ═══════════════════════════════════════════════════════════════════════
+// Used instead of rand(): every game owns its own stream, so results do
+// not depend on anything else that draws random numbers.
+struct SimRng {
+    uint64_t state;
+    uint64_t inc;
+};
+
+void seedRng(SimRng& rng, uint64_t seed);
+uint32_t rngNext(SimRng& rng);
+int rngRange(SimRng& rng, int n);   // Uniform in [0, n)
+
+// ═══════════════════════════════════════════════════════════════════════
+// ECONOMY
+// ═══════════════════════════════════════════════════════════════════════
+// Values from 01_Economy.cpp that stay the same for a whole game.
+// Read once by initGame() (and by reloadEconomyConfig()) so the
+// per-tower, per-enemy and per-frame loops do not call them again.
+struct EconomyConfig {
+    int startingMoney;
+    int baseHealth;
+    std::string commanderName;
+    int towerCost;
+    int towerBaseDamage;
+    double towerRange;
+    int killBonus;
+};
+
+// ═══════════════════════════════════════════════════════════════════════
+// GRID
+// ═══════════════════════════════════════════════════════════════════════
+// The map is gridWidth x gridHeight cells (set with setGridSize() before
+// initGame()). It is split into square chunks of GRID_CHUNK_SIZE cells;
+// every chunk stores the tower slot on each of its cells (-1 = empty) and
+// the list of towers on it, so lookups are O(1) and the renderer only
+// touches the chunks on screen. Forked worlds share the chunks no tower
+// was built on (see Cow.h). The HQ is on the last column, in the middle two rows.
+const int DEFAULT_GRID_SIZE = 10;
+const int MIN_GRID_SIZE = 8;      // Room for the HQ and the five enemy lanes
+const int MAX_GRID_SIZE = 512;
+const int GRID_CHUNK_SIZE = 16;
+
+struct GridChunk {
+    int towerAt[GRID_CHUNK_SIZE * GRID_CHUNK_SIZE];   // Tower slot per cell, -1 = empty
+    std::vector<int> towers;                          // Tower slots on this chunk
+};
+
+const int SPAWN_LANES = 5;        // Rows enemies start on, at column 0
+
+// ═══════════════════════════════════════════════════════════════════════
+// CAPACITY
+// ═══════════════════════════════════════════════════════════════════════
+// How many towers and enemies a game can hold. The defaults are the
+// classic limits; stress-test maps raise them (up to the *_LIMIT values)
+// with setCapacity() before initGame(). The storage grows on demand, and
+// slot indices (e.g. a selected tower) stay valid while it grows.
+const int DEFAULT_MAX_TOWERS = 10;
+const int DEFAULT_MAX_ENEMIES = 20;
+const int MAX_TOWERS_LIMIT = 1000;
+const int MAX_ENEMIES_LIMIT = 10000;
+
+// Tower data (support multiple towers)
+// Loop over towers.capacity() and skip slots that are not active.
+struct Tower {
+    int gridX;
+    int gridY;
+    float cooldown;
+    bool active;
+    int kills;       // Track kills for upgrade system
+    int level;       // Tower level (1-5)
+    std::string type; // "laser", "missile", "plasma"
+};
+const int TOWER_POOL_GROW = 16;      // Tower slots added at a time
+
+// Enemy data - Structure of Arrays
+// Live enemies are packed into [0, count): enemy i is x[i], y[i], ...
+// Removing an enemy moves the last one into its slot (swap-remove), so
+// loops only ever touch live enemies and never branch on an alive flag.
+// The arrays double in size when full, up to maxEnemies. Each one is
+// split into copy-on-write chunks of ENEMY_CHUNK_SIZE (see Cow.h), so a
+// forked world keeps sharing e.g. speed and id while only x and y change.
+// An enemy walks in a straight line to the centre of the next flow field
+// cell; its velocity is only worked out again when it enters a new cell
+// or the field changes. With no path it walks straight at the HQ column.
+const int ENEMY_CHUNK_SIZE = 256;   // A multiple of the SIMD width
+
+struct EnemyStore {
+    CowArray<float, ENEMY_CHUNK_SIZE> x;       // Pixel position for smooth movement
+    CowArray<float, ENEMY_CHUNK_SIZE> y;
+    CowArray<float, ENEMY_CHUNK_SIZE> speed;   // Pixels per second along the path
+    CowArray<float, ENEMY_CHUNK_SIZE> velX;    // Current velocity (pixels per second)
+    CowArray<float, ENEMY_CHUNK_SIZE> velY;
+    CowArray<int, ENEMY_CHUNK_SIZE> cell;      // Packed cell it is in (see packEnemyCell)
+    CowArray<int, ENEMY_CHUNK_SIZE> health;    // <= 0 means killed, removed at end of tick
+    CowArray<int, ENEMY_CHUNK_SIZE> id;        // Spawn number - stable while slots move
+    int count = 0;
+};
+
+// Projectile data for visual effects
+// Slots come from a pool that grows when full, so fast-firing towers
+// never lose a shot; loop over projectiles.capacity() and skip !active.
+struct Projectile {
+    float x, y;
+    float targetX, targetY;
+    float speed;
+    bool active;
+};
+const int PROJECTILE_POOL_START = 64;   // Slots allocated by initGame()
+const int PROJECTILE_POOL_GROW = 64;    // Slots added each time it is full
+
+// ═══════════════════════════════════════════════════════════════════════
+// RADAR STATISTICS
+// ═══════════════════════════════════════════════════════════════════════
+// Everything the RADAR panel and the threat banner show. Worked out at
+// most once per simulation tick, from a single radar list, by the
+// student's 04_Radar.cpp functions; every frame drawn during the same
+// tick (or while paused) reuses it.
+const double RADAR_CLOSE_DISTANCE = 5.0;   // "Close" and flying-in-range limit
+const int RADAR_DANGER_HEALTH = 75;        // Threat banner threshold
+
+struct RadarStats {
+    std::vector<RadarEnemy> enemies;   // The radar list the numbers come from
+    int total;
+    int close;
+    int totalHealth;
+    double closest;
+    int strongest;
+    int flyingInRange;
+    int firstDangerous;                // Index into enemies, -1 if none
+};
+
+// What one tower decided in the parallel half of the tower update
+// (see TOWER TARGETING in Simulation.cpp)
+struct TowerDecision {
+    bool coolingDown;      // Cooldown to count down in phase 2
+    bool ready;            // Off cooldown: may shoot this tick
+    float cooldownTime;    // Seconds between shots for this tower
+    int nearby[3];         // Enemies it chose from (lowest slots first)
+    int nearbyCount;
+    int target;            // Enemy slot, -1 = nothing near
+    double distance;       // Pixels from the tower to the target
+    bool inRange;
+};
+
+// ═══════════════════════════════════════════════════════════════════════
+// GAME WORLD
+// ═══════════════════════════════════════════════════════════════════════
+// Everything one game needs, including the scratch buffers its tick
+// reuses. Worlds only share the copy-on-write chunks of a fork (see
+// forkWorld()), so each thread can run its own game.
+// Set the map size and capacity, then call initGame().
+struct GameWorld {
+    // Game state
+    int playerMoney = 500;
+    int baseHealth = 100;
+    int score = 0;
+    int wave = 1;
+    EconomyConfig economy;
+
+    // Grid (see GRID)
+    int gridWidth = DEFAULT_GRID_SIZE;
+    int gridHeight = DEFAULT_GRID_SIZE;
+    int chunksX = 1;              // Chunks per row / column
+    int chunksY = 1;
+    CowArray<GridChunk, 1> gridChunks;   // Row by row, chunksX * chunksY
+
+    // Flow field (see FLOW FIELD). Cells are numbered row by row:
+    // cell = gridY * gridWidth + gridX.
+    std::vector<int> flowDistance;   // Steps to the HQ, -1 = no path
+    std::vector<int> flowNext;       // Next cell toward the HQ, -1 = none
+
+    // Capacity (see CAPACITY)
+    int maxTowers = DEFAULT_MAX_TOWERS;
+    int maxEnemies = DEFAULT_MAX_ENEMIES;
+
+    Pool<Tower> towers;
+    int towerCount = 0;
+    int totalPlayerKills = 0;     // Track total kills for player rank
+
+    EnemyStore enemies;
+    int enemyCount = 0;           // Enemies still alive (student-facing count)
+    int nextEnemyId = 0;
+
+    Pool<Projectile> projectiles;
+
+    // Game timing
+    uint64_t gameSeed = 1;        // Seed passed to initGame()
+    SimRng gameRng;               // Random stream of the running game
+    uint32_t simTick = 0;         // Fixed ticks simulated since initGame()
+    float simAccumulator = 0;     // Real time not yet simulated
+    float enemySpawnTimer = 0;
+    float gameSpeed = 1.0f;
+    bool gamePaused = false;
+    bool gameOver = false;
+
+    // Status message (shown by the renderer, set by the simulation)
+    std::string statusMessage = "Click on the grid to place towers!";
+    float messageTimer = 0;
+
+    // Radar statistics cache (see getRadarStats())
+    RadarStats radarStats;
+    bool radarStatsValid = false;   // Cleared by initGame()
+    uint32_t radarStatsTick = 0;
+
+    // Flow field repair bookkeeping (see closeFlowCell()). A cell is
+    // marked by writing the current flowEpoch into it, so nothing has to
+    // be cleared between repairs.
+    std::vector<int> flowQueue;            // BFS queue, one entry per cell at most
+    uint32_t flowEpoch = 0;
+    std::vector<uint32_t> flowCutMark;     // Cell lost its shortest path in this repair
+    std::vector<uint32_t> flowVisitMark;   // Cell queued / its next step changed
+    std::vector<int> flowCut;              // Cells marked in flowCutMark...
+    std::vector<int> flowCutOldDistance;   // ...and their distances before the repair
+    std::vector<std::pair<int, int> > flowHeap;   // (distance, cell), smallest first
+
+    // Enemy bucket index, rebuilt every tick (see rebuildEnemyBuckets())
+    int bucketShift = 0;             // Bucket side = 1 << bucketShift cells
+    int bucketsX = 1;
+    std::vector<int> bucketStart;    // Enemies of bucket b: bucketEnemies[bucketStart[b] .. bucketStart[b+1])
+    std::vector<int> bucketFill;     // Scatter position of every bucket
+    std::vector<int> bucketEnemies;  // Sized to enemies.count by rebuildEnemyBuckets()
+    std::vector<int> enemyBucket;    // Bucket of each enemy
+    std::vector<short> enemyCellX;   // Cell of each enemy
+    std::vector<short> enemyCellY;
+
+    // Scripted player of the runners (see PlacementPolicy.h)
+    int policyUpgradeMoney = -1;   // Money at its last auto-upgrade (cleared by initGame())
+
+    // Per-tick scratch of updateGame()
+    std::vector<TowerDecision> towerDecisions;   // One per tower slot
+    std::vector<int> movedEnemies;               // Enemies that entered a new cell
+    std::vector<int> breachedEnemies;
+};
+
+// ═══════════════════════════════════════════════════════════════════════
+// SETUP
+// ═══════════════════════════════════════════════════════════════════════
+void reloadEconomyConfig(GameWorld& world);   // Sample the 01_Economy.cpp functions again
+void setGridSize(GameWorld& world, int width, int height);    // Clamped to [MIN, MAX]_GRID_SIZE
+void setCapacity(GameWorld& world, int towerSlots, int enemySlots);   // Clamped to [1, limit]
+
+// ═══════════════════════════════════════════════════════════════════════
+// HELPER FUNCTIONS
+// ═══════════════════════════════════════════════════════════════════════
+
+// Pixel position in the play field (same units as enemy x/y)
+struct SimPoint { float x, y; };
+
+SimPoint gridToWorld(int gridX, int gridY);
+bool isValidGridPos(const GameWorld& world, int gridX, int gridY);
+GridChunk& chunkAt(GameWorld& world, int gridX, int gridY);   // Chunk holding a (valid) cell, to change it
+const GridChunk& chunkAt(const GameWorld& world, int gridX, int gridY);
+bool hasTowerAt(const GameWorld& world, int gridX, int gridY);     // O(1), from the occupancy grid
+int towerIndexAt(const GameWorld& world, int gridX, int gridY);    // Tower slot on a cell, -1 if none
+int getBaseRow(const GameWorld& world);                  // Upper of the two HQ rows
+int getSpawnRow(const GameWorld& world, int waveNumber);
+bool isBasePosition(const GameWorld& world, int gridX, int gridY);
+double calculateDistance(float x1, float y1, float x2, float y2);
+void setMessage(GameWorld& world, const std::string& msg);
+
+// Conversions into the formats used by the student exercises
+std::vector<RadarEnemy> getRadarEnemies(const GameWorld& world);
+void fillRadarEnemies(const GameWorld& world, std::vector<RadarEnemy>& radarList);   // Reuses the storage
+std::vector<UpgradeTower> getUpgradeTowers(const GameWorld& world);
+UpgradePlayer getUpgradePlayer(const GameWorld& world);
+
+const RadarStats& getRadarStats(GameWorld& world);
+
+// ═══════════════════════════════════════════════════════════════════════
+// FLOW FIELD
+// ═══════════════════════════════════════════════════════════════════════
+// One breadth-first search from the HQ cells gives every cell its number
+// of steps to the HQ around the towers, and the neighbour to walk to.
+// All enemies share it, so pathing does not cost more with more enemies.
+// It is built by initGame(); a new tower only repairs the cells whose
+// path went through its cell (see closeFlowCell()).
+void rebuildFlowField(GameWorld& world);
+void buildFlowField(GameWorld& world);   // Same, but enemies keep their current headings
+
+// Turn a cell into a wall and repair the field around it. With keepPaths,
+// a wall that would cut a spawn lane or a walking enemy off from the HQ
+// is undone and false is returned (the field is left as it was).
+bool closeFlowCell(GameWorld& world, int gridX, int gridY, bool keepPaths);
+
+// ═══════════════════════════════════════════════════════════════════════
+// ENEMIES
+// ═══════════════════════════════════════════════════════════════════════
+int addEnemy(GameWorld& world, float x, float y, int health, float speed);  // -1 at maxEnemies
+void removeEnemyAt(GameWorld& world, int index);                            // swap-remove
+void steerEnemy(GameWorld& world, int index);       // Aim at the next cell of the flow field
+
+// ═══════════════════════════════════════════════════════════════════════
+// GAME FLOW
+// ═══════════════════════════════════════════════════════════════════════
+void initGame(GameWorld& world, uint64_t seed);
+void spawnEnemy(GameWorld& world);
+void fireProjectile(GameWorld& world, float fromX, float fromY, float toX, float toY);
+void updateGame(GameWorld& world, float deltaTime);
+
+// One fixed tick: updateGame(SIM_TICK_SECONDS) and advance simTick
+void stepSimulation(GameWorld& world);
+
+// Feed real elapsed time; runs as many fixed ticks as fit (at most
+// SIM_MAX_CATCHUP_TICKS) and keeps the remainder. Returns ticks run.
+int advanceSimulation(GameWorld& world, float frameSeconds);
+
+// ═══════════════════════════════════════════════════════════════════════
+// FORKED WORLDS
+// ═══════════════════════════════════════════════════════════════════════
+// Make `branch` a copy of `world` that plays on by itself, e.g. to try
+// out "what if I build here?" (see WhatIf.h). Towers, projectiles,
+// enemies and grid chunks are shared copy-on-write (see Cow.h), so a fork
+// only copies the chunk pointers and the per-cell and scratch vectors.
+// Every GameWorld member is copied, new ones included. `world` must not
+// change while it is being forked; afterwards both may run, also on
+// different threads.
+void forkWorld(const GameWorld& world, GameWorld& branch);
+
+// ═══════════════════════════════════════════════════════════════════════
+// PLAYER ACTIONS
+// ═══════════════════════════════════════════════════════════════════════
+// Shared by mouse/keyboard input and the headless runner, so both
+// go through exactly the same rules.
+
+// Why buildTowerAt() did or did not build
+enum BuildResult {
+    BUILD_OK,
+    BUILD_BAD_CELL,       // Game over, off the map, on the base or taken
+    BUILD_NOT_ALLOWED,    // Not enough credits or no free tower slot
+    BUILD_BLOCKS_PATH     // The tower would wall the enemies off from the HQ
+};
+
+BuildResult buildTowerAt(GameWorld& world, int gridX, int gridY);   // BUILD_OK if a tower was placed
+int placeTower(GameWorld& world, int gridX, int gridY, const std::string& type);  // No checks or cost; -1 if full
+bool upgradeTower(GameWorld& world, int towerIndex);          // true if the tower levelled up
+int autoUpgradeTowers(GameWorld& world);                      // number of towers upgraded
+
+#endif // SIMULATION_H
@@ -0,0 +1,116 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════
+ *  PLANETARY DEFENSE COMMAND - What-If Rollouts
+ * ═══════════════════════════════════════════════════════════════════════
+ *  Forks the game, applies one player action to the branch and plays it
+ *  on. Only the branch changes; the chunks it shares with the live game
+ *  are copied the first time the branch writes to them (see Cow.h).
+ *  NOTE: This file is part of the engine - students should NOT edit this.
+ * ═══════════════════════════════════════════════════════════════════════
+ */
+
+#include "WhatIf.h"
+#include "PlacementPolicy.h"
+#include "JobSystem.h"
+#include <algorithm>
+
+// Fork and lift the pause: a paused player still wants an answer
+static void startBranch(const GameWorld& world, GameWorld& branch) {
+    forkWorld(world, branch);
+    branch.gamePaused = false;
+}
+
+// Play the branch on up to endTick (or until the HQ falls)
+static void playBranchUntil(GameWorld& branch, uint32_t endTick) {
+    while (!branch.gameOver && branch.simTick < endTick) stepSimulation(branch);
+}
+
+// How the branch ended up
+static WhatIfResult branchResult(const GameWorld& branch, bool built, int killsBefore) {
+    WhatIfResult result;
+    result.built = built;
+    result.baseHealth = branch.baseHealth;
+    result.score = branch.score;
+    result.kills = branch.totalPlayerKills - killsBefore;
+    result.playerMoney = branch.playerMoney;
+    result.wave = branch.wave;
+    result.baseDestroyed = branch.gameOver;
+    return result;
+}
+
+// Play the branch for `seconds` and report how it ended
+static WhatIfResult playBranch(GameWorld& branch, bool built, float seconds) {
+    int killsBefore = branch.totalPlayerKills;
+    playBranchUntil(branch, branch.simTick + (uint32_t)(seconds / SIM_TICK_SECONDS));
+    return branchResult(branch, built, killsBefore);
+}
+
+WhatIfResult whatIfTowerAt(const GameWorld& world, GameWorld& branch, int gridX, int gridY, float seconds) {
+    startBranch(world, branch);
+    bool built = buildTowerAt(branch, gridX, gridY) == BUILD_OK;
+    return playBranch(branch, built, seconds);
+}
+
+WhatIfResult whatIfNothing(const GameWorld& world, GameWorld& branch, float seconds) {
+    startBranch(world, branch);
+    return playBranch(branch, false, seconds);
+}
+
+// Did result end better than best? Ties keep the earlier candidate.
+static bool endsBetter(const WhatIfResult& result, const WhatIfResult& best) {
+    if (result.baseHealth != best.baseHealth) return result.baseHealth > best.baseHealth;
+    if (result.kills != best.kills) return result.kills > best.kills;
+    return result.playerMoney > best.playerMoney;
+}
+
+bool startTowerHint(TowerHintSearch& search, const GameWorld& world, float seconds, int maxCandidates) {
+    search.count = 0;
+    search.endTick = world.simTick + (uint32_t)(seconds / SIM_TICK_SECONDS);
+    if (world.gameOver || world.towerCount >= world.maxTowers || world.playerMoney < world.economy.towerCost) return false;
+    if ((int)search.candidates.size() < maxCandidates) search.candidates.resize(maxCandidates);
+
+    int col, row;
+    for (int i = 0; search.count < maxCandidates && getPlacementCell(world, i, col, row); i++) {
+        if (!isValidGridPos(world, col, row) || isBasePosition(world, col, row) || hasTowerAt(world, col, row)) continue;
+
+        // Cells that would block the path are not candidates
+        HintCandidate& candidate = search.candidates[search.count];
+        startBranch(world, candidate.branch);
+        if (buildTowerAt(candidate.branch, col, row) != BUILD_OK) continue;
+
+        candidate.gridX = col;
+        candidate.gridY = row;
+        candidate.killsBefore = world.totalPlayerKills;
+        search.count++;
+    }
+    return search.count > 0;
+}
+
+bool stepTowerHint(TowerHintSearch& search, int ticks) {
+    // One candidate per chunk: each branch is a whole game of its own
+    parallelFor(search.count, 1, [&search, ticks](int begin, int end) {
+        for (int c = begin; c < end; c++) {
+            GameWorld& branch = search.candidates[c].branch;
+            playBranchUntil(branch, std::min(search.endTick, branch.simTick + (uint32_t)ticks));
+        }
+    });
+
+    for (int c = 0; c < search.count; c++) {
+        const GameWorld& branch = search.candidates[c].branch;
+        if (!branch.gameOver && branch.simTick < search.endTick) return false;
+    }
+    return true;
+}
+
+bool getTowerHint(const TowerHintSearch& search, int& bestX, int& bestY, WhatIfResult& best) {
+    for (int c = 0; c < search.count; c++) {
+        const HintCandidate& candidate = search.candidates[c];
+        WhatIfResult result = branchResult(candidate.branch, true, candidate.killsBefore);
+        if (c == 0 || endsBetter(result, best)) {
+            best = result;
+            bestX = candidate.gridX;
+            bestY = candidate.gridY;
+        }
+    }
+    return search.count > 0;
+}
@@ -0,0 +1,84 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════
+ *  PLANETARY DEFENSE COMMAND - What-If Rollouts
+ * ═══════════════════════════════════════════════════════════════════════
+ *  Answers "what happens in the next S seconds if I build a tower here?"
+ *  by forking the running game (see forkWorld()) and playing the branch
+ *  on with no further player actions. The live game is never touched,
+ *  and branch worlds are reused for every rollout, so they stay cheap.
+ *  Used by the [H] hint of the game, which plays its branches a few
+ *  ticks per frame on the job threads (see TowerHintSearch).
+ *  NOTE: This file is part of the engine - students should NOT edit this.
+ * ═══════════════════════════════════════════════════════════════════════
+ */
+
+#ifndef WHAT_IF_H
+#define WHAT_IF_H
+
+#include "Simulation.h"
+#include <cstdint>
+#include <vector>
+
+const float WHAT_IF_SECONDS = 30.0f;   // Default look-ahead
+const int WHAT_IF_CANDIDATES = 12;     // Cells a hint search tries at most
+const int WHAT_IF_TICKS_PER_FRAME = 60;   // Ticks every hint branch plays per frame
+
+// How the branch ended up after the rollout
+struct WhatIfResult {
+    bool built;           // The tower could be built (money, slots, path)
+    int baseHealth;
+    int score;
+    int kills;            // Kills during the rollout
+    int playerMoney;
+    int wave;
+    bool baseDestroyed;
+};
+
+// Fork `world` into `branch`, build a tower on (gridX, gridY) with the
+// normal player rules and run `seconds` of game time (a paused game runs
+// too). Without a tower, the branch is still played, so the result can
+// be compared with doing nothing.
+WhatIfResult whatIfTowerAt(const GameWorld& world, GameWorld& branch, int gridX, int gridY, float seconds);
+
+// Same look-ahead without building anything
+WhatIfResult whatIfNothing(const GameWorld& world, GameWorld& branch, float seconds);
+
+// ═══════════════════════════════════════════════════════════════════════
+// TOWER HINT
+// ═══════════════════════════════════════════════════════════════════════
+// Finds the buildable cell next to the enemy lanes whose branch ends best
+// (most base health, then most kills, then most money), one branch world
+// per candidate. The search is played on in steps, so the game can keep
+// drawing frames while it runs:
+//   startTowerHint(search, world, ...);
+//   while (!stepTowerHint(search, ticks)) { ...draw a frame... }
+//   getTowerHint(search, x, y, result);
+// The branches only depend on the world at startTowerHint(), which may
+// change freely afterwards.
+
+struct HintCandidate {
+    int gridX;
+    int gridY;
+    int killsBefore;      // Kills of the branch when it was forked
+    GameWorld branch;
+};
+
+struct TowerHintSearch {
+    std::vector<HintCandidate> candidates;   // Reused by the next search
+    int count = 0;                            // Candidates in use
+    uint32_t endTick = 0;                     // Tick every branch plays to
+};
+
+// Fork one branch for each of the first maxCandidates cells that can be
+// built on, closest to the HQ first (see getPlacementCell()), and build
+// the tower in it. False if no cell could be built on.
+bool startTowerHint(TowerHintSearch& search, const GameWorld& world, float seconds, int maxCandidates);
+
+// Play every branch on by at most `ticks` ticks, the branches spread over
+// the job threads (see JobSystem.h). True once they have all ended.
+bool stepTowerHint(TowerHintSearch& search, int ticks);
+
+// Cell and result of the best branch of a search that has ended
+bool getTowerHint(const TowerHintSearch& search, int& bestX, int& bestY, WhatIfResult& best);
+
+#endif // WHAT_IF_H
@@ -0,0 +1,293 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════
+ *  PLANETARY DEFENSE COMMAND - Balance Runner
+ * ═══════════════════════════════════════════════════════════════════════
+ *  Monte Carlo balance checks: plays N seeded games with the scripted
+ *  placement policy, spread over every core (each thread plays its own
+ *  GameWorld), and writes aggregate statistics as CSV. Use it to see what
+ *  a change to getWaveBonus(), getKillBonus(), calculateFireRate() or the
+ *  upgrade costs does to a few thousand games.
+ *  Results only depend on the seeds, not on the number of threads.
+ *  NOTE: This file is part of the engine - students should NOT edit this.
+ *
+ *  USAGE:
+ *    balance [--games N] [--seconds S] [--seed X] [--threads N]
+ *            [--sample S] [--csv FILE] [--max-towers N] [--max-enemies N]
+ *            [--grid WxH] [--load FILE]
+ * ═══════════════════════════════════════════════════════════════════════
+ */
+
+#include "Simulation.h"
+#include "PlacementPolicy.h"
+#include "SaveState.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// ═══════════════════════════════════════════════════════════════════════
+// RUN SETTINGS
+// ═══════════════════════════════════════════════════════════════════════
+struct BalanceOptions {
+    int games = 1000;            // Number of games to simulate
+    float maxSeconds = 600.0f;   // Stop a game after this much game time
+    uint64_t seed = 1;           // Seed of the first game (game g uses seed + g)
+    int threads = 0;             // Games played at once, 0 = one per core
+    float sampleSeconds = 30.0f; // Money is sampled every S seconds of game time
+    const char* csvPath = "balance.csv";
+    int maxTowers = DEFAULT_MAX_TOWERS;
+    int maxEnemies = DEFAULT_MAX_ENEMIES;
+    int gridWidth = DEFAULT_GRID_SIZE;
+    int gridHeight = DEFAULT_GRID_SIZE;
+    const char* loadPath = nullptr;     // Start every game from this save state
+    const GameWorld* saved = nullptr;   // ...once main() has loaded it
+};
+
+// Everything recorded about one game
+struct BalanceGame {
+    int wavesSurvived;
+    int score;
+    int kills;
+    float secondsPlayed;
+    bool baseDestroyed;
+    std::vector<int> money;        // playerMoney at 0, S, 2S, ... seconds
+    std::vector<int> towerKills;   // Kills of the 1st, 2nd, ... tower built
+};
+
+// ═══════════════════════════════════════════════════════════════════════
+// ONE GAME
+// ═══════════════════════════════════════════════════════════════════════
+
+void playGame(GameWorld& world, const BalanceOptions& options, uint64_t seed, BalanceGame& game) {
+    if (options.saved) {
+        branchFromSaveState(*options.saved, world, seed);   // Brings its own map and capacity
+    } else {
+        setCapacity(world, options.maxTowers, options.maxEnemies);
+        setGridSize(world, options.gridWidth, options.gridHeight);
+        initGame(world, seed);
+    }
+
+    uint32_t startTick = world.simTick;
+    uint32_t maxTicks = (uint32_t)(options.maxSeconds / SIM_TICK_SECONDS);
+    uint32_t sampleTicks = (uint32_t)(options.sampleSeconds / SIM_TICK_SECONDS);
+    if (sampleTicks < 1) sampleTicks = 1;
+
+    game.money.clear();
+    while (!world.gameOver && world.simTick - startTick < maxTicks) {
+        if ((world.simTick - startTick) % sampleTicks == 0) game.money.push_back(world.playerMoney);
+        runPlacementPolicy(world);
+        stepSimulation(world);
+    }
+
+    game.wavesSurvived = world.wave - 1;
+    game.score = world.score;
+    game.kills = world.totalPlayerKills;
+    game.secondsPlayed = (world.simTick - startTick) * SIM_TICK_SECONDS;
+    game.baseDestroyed = world.gameOver;
+
+    // Towers are never sold, so slot order is build order
+    game.towerKills.clear();
+    for (int t = 0; t < world.towers.capacity(); t++) {
+        if (world.towers[t].active) game.towerKills.push_back(world.towers[t].kills);
+    }
+}
+
+// Each thread takes the next unplayed game until none are left. The
+// result goes to the game's own entry, so the order games finish in
+// does not matter.
+void playGames(const BalanceOptions& options, std::vector<BalanceGame>& games, std::atomic<int>& nextGame) {
+    GameWorld world;   // Reused for every game this thread plays
+    for (;;) {
+        int g = nextGame.fetch_add(1);
+        if (g >= (int)games.size()) return;
+        playGame(world, options, options.seed + g, games[g]);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// STATISTICS
+// ═══════════════════════════════════════════════════════════════════════
+struct BalanceStat {
+    int count = 0;
+    double sum = 0;
+    double sumSquares = 0;
+    double min = 0;
+    double max = 0;
+
+    void add(double value) {
+        if (count == 0 || value < min) min = value;
+        if (count == 0 || value > max) max = value;
+        count++;
+        sum += value;
+        sumSquares += value * value;
+    }
+    double mean() const { return count > 0 ? sum / count : 0.0; }
+    double stddev() const {
+        if (count < 2) return 0.0;
+        double variance = (sumSquares - sum * sum / count) / (count - 1);
+        return variance > 0 ? sqrt(variance) : 0.0;
+    }
+};
+
+// One CSV row: metric,key,games,mean,stddev,min,max
+void writeStatRow(FILE* file, const char* metric, const char* key, const BalanceStat& stat) {
+    fprintf(file, "%s,%s,%d,%.4f,%.4f,%.4f,%.4f\n",
+            metric, key, stat.count, stat.mean(), stat.stddev(), stat.min, stat.max);
+}
+
+// Money is aggregated over the games still running at each sample, so
+// "games" drops as bases fall; tower kills over the games that built
+// that many towers.
+bool writeCsv(const BalanceOptions& options, const std::vector<BalanceGame>& games) {
+    FILE* file = fopen(options.csvPath, "w");
+    if (!file) return false;
+
+    BalanceStat waves, score, kills, seconds, destroyed;
+    std::vector<BalanceStat> money;
+    std::vector<BalanceStat> towerKills;
+    for (const BalanceGame& game : games) {
+        waves.add(game.wavesSurvived);
+        score.add(game.score);
+        kills.add(game.kills);
+        seconds.add(game.secondsPlayed);
+        destroyed.add(game.baseDestroyed ? 1 : 0);
+        if (money.size() < game.money.size()) money.resize(game.money.size());
+        for (size_t s = 0; s < game.money.size(); s++) money[s].add(game.money[s]);
+        if (towerKills.size() < game.towerKills.size()) towerKills.resize(game.towerKills.size());
+        for (size_t t = 0; t < game.towerKills.size(); t++) towerKills[t].add(game.towerKills[t]);
+    }
+
+    fprintf(file, "metric,key,games,mean,stddev,min,max\n");
+    writeStatRow(file, "waves_survived", "", waves);
+    writeStatRow(file, "score", "", score);
+    writeStatRow(file, "kills", "", kills);
+    writeStatRow(file, "seconds_played", "", seconds);
+    writeStatRow(file, "base_destroyed", "", destroyed);
+
+    char key[32];
+    for (size_t s = 0; s < money.size(); s++) {
+        snprintf(key, sizeof(key), "%.0f", s * options.sampleSeconds);
+        writeStatRow(file, "money_at_second", key, money[s]);
+    }
+    for (size_t t = 0; t < towerKills.size(); t++) {
+        snprintf(key, sizeof(key), "%d", (int)t + 1);
+        writeStatRow(file, "tower_kills", key, towerKills[t]);
+    }
+
+    bool ok = ferror(file) == 0;
+    fclose(file);
+    return ok;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// COMMAND LINE
+// ═══════════════════════════════════════════════════════════════════════
+
+void printUsage() {
+    printf("Usage: balance [--games N] [--seconds S] [--seed X] [--threads N] [--sample S] [--csv FILE]\n");
+    printf("  --games N     number of games to simulate (default 1000)\n");
+    printf("  --seconds S   max game time per game in seconds (default 600)\n");
+    printf("  --seed X      seed of the first game (default 1)\n");
+    printf("  --threads N   games played at once (default: one per core)\n");
+    printf("  --sample S    seconds of game time between money samples (default 30)\n");
+    printf("  --csv FILE    where to write the aggregate CSV (default balance.csv)\n");
+    printf("  --max-towers N   tower capacity (default %d, up to %d)\n", DEFAULT_MAX_TOWERS, MAX_TOWERS_LIMIT);
+    printf("  --max-enemies N  enemy capacity (default %d, up to %d)\n", DEFAULT_MAX_ENEMIES, MAX_ENEMIES_LIMIT);
+    printf("  --grid WxH    map size in cells, or N for NxN (default %d, up to %d)\n", DEFAULT_GRID_SIZE, MAX_GRID_SIZE);
+    printf("  --load F      start every game from save state F (e.g. the F5 checkpoint\n");
+    printf("                of the game); times are counted from there\n");
+}
+
+bool parseOptions(int argc, char** argv, BalanceOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = (i + 1 < argc);
+        if (strcmp(argv[i], "--games") == 0 && hasValue) {
+            options.games = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seconds") == 0 && hasValue) {
+            options.maxSeconds = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            options.seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--threads") == 0 && hasValue) {
+            options.threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--sample") == 0 && hasValue) {
+            options.sampleSeconds = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--csv") == 0 && hasValue) {
+            options.csvPath = argv[++i];
+        } else if (strcmp(argv[i], "--max-towers") == 0 && hasValue) {
+            options.maxTowers = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--max-enemies") == 0 && hasValue) {
+            options.maxEnemies = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--grid") == 0 && hasValue) {
+            int found = sscanf(argv[++i], "%dx%d", &options.gridWidth, &options.gridHeight);
+            if (found == 1) options.gridHeight = options.gridWidth;
+        } else if (strcmp(argv[i], "--load") == 0 && hasValue) {
+            options.loadPath = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return options.games > 0 && options.maxSeconds > 0 && options.sampleSeconds > 0;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// MAIN ENTRY POINT
+// ═══════════════════════════════════════════════════════════════════════
+// The tower job system is left off: every core already plays a game.
+
+int main(int argc, char** argv) {
+    BalanceOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    // Every thread forks its games from the same loaded world
+    GameWorld saved;
+    if (options.loadPath) {
+        if (!loadStateFile(options.loadPath, saved)) {
+            printf("Could not load save state %s\n", options.loadPath);
+            return 1;
+        }
+        options.saved = &saved;
+    }
+
+    int threadCount = options.threads > 0 ? options.threads : (int)std::thread::hardware_concurrency();
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > options.games) threadCount = options.games;
+
+    std::vector<BalanceGame> games(options.games);
+    std::atomic<int> nextGame(0);
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threadCount; i++) {
+        workers.emplace_back(playGames, std::cref(options), std::ref(games), std::ref(nextGame));
+    }
+    playGames(options, games, nextGame);
+    for (std::thread& worker : workers) worker.join();
+
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (!writeCsv(options, games)) {
+        printf("Could not write %s\n", options.csvPath);
+        return 1;
+    }
+
+    long long totalWaves = 0;
+    int destroyed = 0;
+    for (const BalanceGame& game : games) {
+        totalWaves += game.wavesSurvived;
+        if (game.baseDestroyed) destroyed++;
+    }
+    printf("games: %d  base destroyed: %d  threads: %d\n", options.games, destroyed, threadCount);
+    printf("waves survived: avg %.2f\n", (double)totalWaves / options.games);
+    printf("played in %.3f s (%.0f games/min), statistics in %s\n",
+           wallSeconds, wallSeconds > 0 ? options.games * 60.0 / wallSeconds : 0.0, options.csvPath);
+    return 0;
+}
@@ -0,0 +1,303 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════
+ *  PLANETARY DEFENSE COMMAND - Headless Runner
+ * ═══════════════════════════════════════════════════════════════════════
+ *  Runs whole games WITHOUT a window: no Raylib, no rendering, no input.
+ *  The simulation is stepped in fixed ticks with a scripted tower
+ *  placement policy, so thousands of games can be simulated per minute
+ *  for balance checks and regression tests (e.g. on CI machines).
+ *  A game is fully determined by its seed.
+ *  NOTE: This file is part of the engine - students should NOT edit this.
+ *
+ *  USAGE:
+ *    headless [--games N] [--seconds S] [--seed X] [--simd K] [--verbose]
+ *             [--max-towers N] [--max-enemies N] [--grid WxH] [--threads N]
+ *             [--load FILE] [--save FILE]
+ *    headless --replay FILE      (play back a session recorded by the game)
+ *    headless --bench            (tick time for growing entity counts)
+ * ═══════════════════════════════════════════════════════════════════════
+ */
+
+#include "Simulation.h"
+#include "EnemyKernels.h"
+#include "JobSystem.h"
+#include "PlacementPolicy.h"
+#include "Replay.h"
+#include "SaveState.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// ═══════════════════════════════════════════════════════════════════════
+// RUN SETTINGS
+// ═══════════════════════════════════════════════════════════════════════
+struct HeadlessOptions {
+    int games = 100;             // Number of games to simulate
+    float maxSeconds = 600.0f;   // Stop a game after this much game time
+    uint64_t seed = 1;
+    bool verbose = false;        // One line per game
+    const char* replayPath = nullptr;  // Play back this recording instead
+    bool bench = false;          // Time ticks for growing entity counts
+    int maxTowers = DEFAULT_MAX_TOWERS;
+    int maxEnemies = DEFAULT_MAX_ENEMIES;
+    int gridWidth = DEFAULT_GRID_SIZE;
+    int gridHeight = DEFAULT_GRID_SIZE;
+    int threads = 0;             // Tower targeting threads, 0 = one per core
+    const char* loadPath = nullptr;   // Start every game from this save state
+    const char* savePath = nullptr;   // Save the first game here when it ends
+};
+
+struct GameResult {
+    int wavesSurvived;
+    int score;
+    int kills;
+    int towersBuilt;
+    int money;
+    float secondsPlayed;
+    bool baseDestroyed;
+};
+
+// ═══════════════════════════════════════════════════════════════════════
+// ONE GAME
+// ═══════════════════════════════════════════════════════════════════════
+// The scripted placement policy (PlacementPolicy.cpp) plays until the
+// base falls or the time limit is reached. With a save state (`saved`),
+// the game goes on from there instead of starting a new one.
+
+GameResult runGame(GameWorld& world, const HeadlessOptions& options, uint64_t seed, const GameWorld* saved) {
+    if (saved) branchFromSaveState(*saved, world, seed);
+    else initGame(world, seed);
+
+    uint32_t startTick = world.simTick;
+    uint32_t maxTicks = (uint32_t)(options.maxSeconds / SIM_TICK_SECONDS);
+    while (!world.gameOver && world.simTick - startTick < maxTicks) {
+        runPlacementPolicy(world);
+        stepSimulation(world);
+    }
+
+    GameResult result;
+    result.wavesSurvived = world.wave - 1;
+    result.score = world.score;
+    result.kills = world.totalPlayerKills;
+    result.towersBuilt = world.towerCount;
+    result.money = world.playerMoney;
+    result.secondsPlayed = (world.simTick - startTick) * SIM_TICK_SECONDS;
+    result.baseDestroyed = world.gameOver;
+    return result;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// COMMAND LINE
+// ═══════════════════════════════════════════════════════════════════════
+
+void printUsage() {
+    printf("Usage: headless [--games N] [--seconds S] [--seed X] [--simd K] [--verbose]\n");
+    printf("  --games N     number of games to simulate (default 100)\n");
+    printf("  --seconds S   max game time per game in seconds, from the save state\n");
+    printf("                with --load (default 600)\n");
+    printf("  --seed X      seed of the first game (default 1)\n");
+    printf("  --simd K      force enemy kernel: avx2, sse2 or scalar (default: best)\n");
+    printf("  --verbose     print one line per game\n");
+    printf("  --max-towers N   tower capacity (default %d, up to %d)\n", DEFAULT_MAX_TOWERS, MAX_TOWERS_LIMIT);
+    printf("  --max-enemies N  enemy capacity (default %d, up to %d)\n", DEFAULT_MAX_ENEMIES, MAX_ENEMIES_LIMIT);
+    printf("  --grid WxH    map size in cells, or N for NxN (default %d, up to %d)\n", DEFAULT_GRID_SIZE, MAX_GRID_SIZE);
+    printf("  --threads N   tower targeting threads (default: one per core)\n");
+    printf("  --load F      start every game from save state F (e.g. the F5 checkpoint\n");
+    printf("                of the game), each seed playing a different future\n");
+    printf("  --save F      write the first game to save state F when it ends\n");
+    printf("  --replay F    play back a session recorded with: game --record F\n");
+    printf("  --bench       time one tick for growing enemy counts (towers: --max-towers)\n");
+}
+
+bool parseOptions(int argc, char** argv, HeadlessOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = (i + 1 < argc);
+        if (strcmp(argv[i], "--games") == 0 && hasValue) {
+            options.games = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seconds") == 0 && hasValue) {
+            options.maxSeconds = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            options.seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--simd") == 0 && hasValue) {
+            if (!setEnemyKernel(argv[++i])) {
+                printf("SIMD kernel '%s' is not supported on this CPU\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--max-towers") == 0 && hasValue) {
+            options.maxTowers = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--max-enemies") == 0 && hasValue) {
+            options.maxEnemies = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--grid") == 0 && hasValue) {
+            int found = sscanf(argv[++i], "%dx%d", &options.gridWidth, &options.gridHeight);
+            if (found == 1) options.gridHeight = options.gridWidth;
+        } else if (strcmp(argv[i], "--threads") == 0 && hasValue) {
+            options.threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--bench") == 0) {
+            options.bench = true;
+        } else if (strcmp(argv[i], "--load") == 0 && hasValue) {
+            options.loadPath = argv[++i];
+        } else if (strcmp(argv[i], "--save") == 0 && hasValue) {
+            options.savePath = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && hasValue) {
+            options.replayPath = argv[++i];
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            options.verbose = true;
+        } else {
+            return false;
+        }
+    }
+    return options.games > 0 && options.maxSeconds > 0;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// REPLAY
+// ═══════════════════════════════════════════════════════════════════════
+// Feeds a recorded session back through the same commands as the game,
+// then prints the final state so it can be compared with the bug report.
+
+int runReplay(GameWorld& world, const char* path) {
+    ReplayLog log;
+    if (!loadReplay(path, log)) {
+        printf("Could not read replay file %s\n", path);
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    bool ok = playReplay(world, log);
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("replay %s: seed %llu, %zu commands, %u ticks\n",
+           path, (unsigned long long)log.seed, log.commands.size(), log.endTick);
+    if (!ok) {
+        printf("  [desync] stopped at tick %u (paused %d, game over %d)\n", world.simTick, world.gamePaused, world.gameOver);
+    }
+    printf("  wave %d score %d kills %d towers %d money %d base %d%s\n",
+           world.wave, world.score, world.totalPlayerKills, world.towerCount, world.playerMoney, world.baseHealth,
+           world.gameOver ? " [base destroyed]" : "");
+    printf("  replayed %.0f s of game time in %.3f s\n", world.simTick * SIM_TICK_SECONDS, wallSeconds);
+    return ok ? 0 : 1;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// CAPACITY BENCHMARK
+// ═══════════════════════════════════════════════════════════════════════
+// Times the simulation tick with a fixed number of live enemies, for
+// growing enemy counts. Free cells get towers up to --max-towers. Enemies cannot die during the run, and the ones that reach
+// the base are replaced after every tick, so the count stays the same.
+
+const int BENCH_TICKS = 600;
+const int BENCH_HEALTH = 1 << 30;
+
+int benchSpawned = 0;   // Spreads the enemies over every lane and column
+
+void fillBenchEnemies(GameWorld& world, int target) {
+    int laneCount = world.gridHeight;
+    int columnCount = world.gridWidth - 1;   // Enemies past the last column breach
+    while (world.enemies.count < target) {
+        int k = benchSpawned++;
+        float x = (float)(GRID_OFFSET_X + (k / laneCount) % columnCount * CELL_SIZE);
+        float y = (float)(GRID_OFFSET_Y + (k % laneCount) * CELL_SIZE + CELL_SIZE / 2);
+        if (addEnemy(world, x, y, BENCH_HEALTH, 30.0f) < 0) break;
+        world.enemyCount++;
+    }
+}
+
+int runBenchmark(GameWorld& world, const HeadlessOptions& options) {
+    static const int enemyCounts[] = { 10, 100, 1000, 10000 };
+
+    printf("threads: %d\n", getJobThreadCount());
+    printf("%8s %7s %12s %12s\n", "enemies", "towers", "avg ms/tick", "max ms/tick");
+    for (int target : enemyCounts) {
+        setCapacity(world, options.maxTowers, target);
+        setGridSize(world, options.gridWidth, options.gridHeight);
+        initGame(world, options.seed);
+        benchSpawned = 0;
+        for (int y = 0; y < world.gridHeight && world.towerCount < world.maxTowers; y++) {
+            for (int x = 0; x < world.gridWidth && world.towerCount < world.maxTowers; x++) {
+                if (!isBasePosition(world, x, y)) placeTower(world, x, y, "laser");
+            }
+        }
+
+        double total = 0, worst = 0;
+        for (int t = 0; t < BENCH_TICKS; t++) {
+            fillBenchEnemies(world, target);
+            world.baseHealth = BENCH_HEALTH;   // Breaches must not end the run
+
+            auto start = std::chrono::steady_clock::now();
+            stepSimulation(world);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            total += ms;
+            if (ms > worst) worst = ms;
+        }
+        printf("%8d %7d %12.4f %12.4f\n", target, world.towerCount, total / BENCH_TICKS, worst);
+    }
+    return 0;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// MAIN ENTRY POINT
+// ═══════════════════════════════════════════════════════════════════════
+
+int main(int argc, char** argv) {
+    HeadlessOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+    startJobSystem(options.threads);   // Same results for any thread count
+
+    // One world, reused by every game (it keeps the memory it grew to)
+    GameWorld world;
+    if (options.replayPath) return runReplay(world, options.replayPath);
+    if (options.bench) return runBenchmark(world, options);
+    setCapacity(world, options.maxTowers, options.maxEnemies);
+    setGridSize(world, options.gridWidth, options.gridHeight);
+
+    // A save state brings its own map and capacity
+    GameWorld saved;
+    if (options.loadPath && !loadStateFile(options.loadPath, saved)) {
+        printf("Could not load save state %s\n", options.loadPath);
+        return 1;
+    }
+
+    long long totalWaves = 0, totalScore = 0, totalKills = 0;
+    int minWaves = -1, maxWaves = 0, destroyed = 0;
+    double totalGameSeconds = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int g = 0; g < options.games; g++) {
+        GameResult r = runGame(world, options, options.seed + g, options.loadPath ? &saved : nullptr);
+        if (g == 0 && options.savePath && !saveStateFile(options.savePath, world)) {
+            printf("Could not write save state %s\n", options.savePath);
+            return 1;
+        }
+
+        totalWaves += r.wavesSurvived;
+        totalScore += r.score;
+        totalKills += r.kills;
+        totalGameSeconds += r.secondsPlayed;
+        if (minWaves < 0 || r.wavesSurvived < minWaves) minWaves = r.wavesSurvived;
+        if (r.wavesSurvived > maxWaves) maxWaves = r.wavesSurvived;
+        if (r.baseDestroyed) destroyed++;
+
+        if (options.verbose) {
+            printf("game %d seed %llu: waves %d score %d kills %d towers %d money %d time %.1fs%s\n",
+                   g, (unsigned long long)(options.seed + g), r.wavesSurvived, r.score, r.kills, r.towersBuilt,
+                   r.money, r.secondsPlayed, r.baseDestroyed ? " [base destroyed]" : "");
+        }
+    }
+
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("games: %d  base destroyed: %d  (enemy kernel: %s, threads: %d)\n",
+           options.games, destroyed, getEnemyKernelName(), getJobThreadCount());
+    printf("waves survived: avg %.2f  min %d  max %d\n",
+           (double)totalWaves / options.games, minWaves, maxWaves);
+    printf("avg score: %.1f  avg kills: %.1f\n",
+           (double)totalScore / options.games, (double)totalKills / options.games);
+    printf("simulated %.0f s of game time in %.3f s (%.0f games/min)\n",
+           totalGameSeconds, wallSeconds, wallSeconds > 0 ? options.games * 60.0 / wallSeconds : 0.0);
+    return 0;
+}
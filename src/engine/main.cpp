@@ -15,9 +15,21 @@
  */
 
 #include "raylib.h"
+#include "rlgl.h"
 #include "GameEngine.h"
+#include "Simulation.h"
+#include "Replay.h"
+#include "SaveState.h"
+#include "WhatIf.h"
+#include "Exercises.h"
+#include "JobSystem.h"
 #include <string>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <unordered_map>
 #include <vector>
 
 // ═══════════════════════════════════════════════════════════════════════
@@ -44,19 +56,11 @@
 #endif
 
 // ═══════════════════════════════════════════════════════════════════════
-// GAME CONSTANTS
+// RENDER CONSTANTS
 // ═══════════════════════════════════════════════════════════════════════
+// Grid, tower and game state constants live in Simulation.h
 const int SCREEN_WIDTH = 800;
 const int SCREEN_HEIGHT = 660;  // Extended for button bar below grid
-const int GRID_SIZE = 10;
-const int CELL_SIZE = 50;
-const int GRID_OFFSET_X = 50;
-const int GRID_OFFSET_Y = 100;
-
-const int TOWER_COST = 100;
-const double TOWER_RANGE = 3.0;
-const int TOWER_BASE_DAMAGE = 10;
-const int TOWER_LEVEL = 1;
 
 // Colors - Space Theme
 const Color COLOR_BACKGROUND = { 8, 8, 24, 255 };         // Deep space
@@ -86,65 +90,18 @@ Font gameFont;
 bool fontLoaded = false;
 
 // ═══════════════════════════════════════════════════════════════════════
-// GAME STATE
+// UI STATE
 // ═══════════════════════════════════════════════════════════════════════
-int playerMoney = 500;
-int baseHealth = 100;
-int score = 0;
-int wave = 1;
-
-// Tower data (support multiple towers)
-struct Tower {
-    int gridX;
-    int gridY;
-    float cooldown;
-    bool active;
-    int kills;       // Track kills for upgrade system
-    int level;       // Tower level (1-5)
-    std::string type; // "laser", "missile", "plasma"
-};
-const int MAX_TOWERS = 10;
-Tower towers[MAX_TOWERS];
-int towerCount = 0;
-int totalPlayerKills = 0;  // Track total kills for player rank
-
-// Enemy data (support multiple enemies)
-struct GameEnemy {
-    float x;       // Pixel position for smooth movement
-    float y;
-    int health;
-    float speed;
-    bool alive;
-};
-const int MAX_ENEMIES = 20;
-GameEnemy enemies[MAX_ENEMIES];
-int enemyCount = 0;
-
-// Projectile data for visual effects
-struct Projectile {
-    float x, y;
-    float targetX, targetY;
-    float speed;
-    bool active;
-};
-const int MAX_PROJECTILES = 50;
-Projectile projectiles[MAX_PROJECTILES];
-
-// Game timing
-float enemySpawnTimer = 0;
-float gameSpeed = 1.0f;
-bool gamePaused = false;
-bool gameOver = false;
-
-// UI State
 int hoveredCellX = -1;
 int hoveredCellY = -1;
-std::string statusMessage = "Click on the grid to place towers!";
-float messageTimer = 0;
+int hintCellX = -1;   // Cell suggested by [H], -1 = none
+int hintCellY = -1;
+bool hintSearching = false;   // An [H] search is playing its branches
 
 // Button/Selection State
 int selectedTowerIndex = -1;  // -1 = no tower selected
 bool showUpgradePanel = false;
+bool showExercisePanel = false;   // [E] which exercises are solved
 
 // Button rectangles (defined here for click detection)
 Rectangle btnRestart = {0, 0, 0, 0};
@@ -152,387 +109,937 @@ Rectangle btnAutoUpgrade = {0, 0, 0, 0};
 Rectangle btnUpgradeTower = {0, 0, 0, 0};
 
 // ═══════════════════════════════════════════════════════════════════════
-// HELPER FUNCTIONS
+// CAMERA / VIEWPORT
 // ═══════════════════════════════════════════════════════════════════════
+// The map is seen through the classic 10x10-cell play area. Bigger maps
+// are scrolled with the arrow keys and zoomed with the mouse wheel, and
+// only what is inside the viewport gets drawn. The classic map always
+// stays exactly where it was (the camera is then the identity).
+const Rectangle VIEWPORT = { (float)GRID_OFFSET_X, (float)GRID_OFFSET_Y,
+                             (float)(DEFAULT_GRID_SIZE * CELL_SIZE), (float)(DEFAULT_GRID_SIZE * CELL_SIZE) };
+const float CAMERA_PAN_SPEED = 600.0f;   // Screen pixels per second
+const float CAMERA_MAX_ZOOM = 1.5f;
+const float GRID_DOT_MIN_PIXELS = 8.0f;  // Cells smaller than this on screen get no dots
+const int TOWER_VIEW_MARGIN = 6;         // Cells around the view whose range circles may show
 
-// Convert grid coordinates to screen pixels
-Vector2 gridToScreen(int gridX, int gridY) {
-    return { 
-        (float)(GRID_OFFSET_X + gridX * CELL_SIZE + CELL_SIZE / 2),
-        (float)(GRID_OFFSET_Y + gridY * CELL_SIZE + CELL_SIZE / 2)
-    };
+Camera2D camera = { { VIEWPORT.x, VIEWPORT.y }, { VIEWPORT.x, VIEWPORT.y }, 0.0f, 1.0f };
+
+// Cells inside the viewport (inclusive), widened by a margin
+struct CellRect { int minX, minY, maxX, maxY; };
+
+bool mapScrolls(const GameWorld& world) {
+    return world.gridWidth > DEFAULT_GRID_SIZE || world.gridHeight > DEFAULT_GRID_SIZE;
 }
 
-// Convert screen pixels to grid coordinates
-void screenToGrid(int screenX, int screenY, int* gridX, int* gridY) {
-    *gridX = (screenX - GRID_OFFSET_X) / CELL_SIZE;
-    *gridY = (screenY - GRID_OFFSET_Y) / CELL_SIZE;
+// Keep the view on the map (centred when the map is smaller than the view)
+void clampCamera(const GameWorld& world) {
+    float mapWidth = (float)(world.gridWidth * CELL_SIZE);
+    float mapHeight = (float)(world.gridHeight * CELL_SIZE);
+    float minZoom = fminf(VIEWPORT.width / mapWidth, VIEWPORT.height / mapHeight);
+    if (minZoom > 1.0f) minZoom = 1.0f;
+    if (camera.zoom < minZoom) camera.zoom = minZoom;
+    if (camera.zoom > CAMERA_MAX_ZOOM) camera.zoom = CAMERA_MAX_ZOOM;
+    
+    float viewWidth = VIEWPORT.width / camera.zoom;
+    float viewHeight = VIEWPORT.height / camera.zoom;
+    if (mapWidth <= viewWidth) camera.target.x = GRID_OFFSET_X + (mapWidth - viewWidth) / 2;
+    else camera.target.x = fmaxf(GRID_OFFSET_X, fminf(camera.target.x, GRID_OFFSET_X + mapWidth - viewWidth));
+    if (mapHeight <= viewHeight) camera.target.y = GRID_OFFSET_Y + (mapHeight - viewHeight) / 2;
+    else camera.target.y = fmaxf(GRID_OFFSET_Y, fminf(camera.target.y, GRID_OFFSET_Y + mapHeight - viewHeight));
 }
 
-// Check if grid position is valid
-bool isValidGridPos(int gridX, int gridY) {
-    return gridX >= 0 && gridX < GRID_SIZE && gridY >= 0 && gridY < GRID_SIZE;
+// Zoom 1, looking along the HQ rows from the spawn side
+void resetCamera(const GameWorld& world) {
+    camera.zoom = 1.0f;
+    camera.target.x = (float)GRID_OFFSET_X;
+    camera.target.y = GRID_OFFSET_Y + (getBaseRow(world) + 1) * CELL_SIZE - VIEWPORT.height / 2;
+    clampCamera(world);
 }
 
-// Check if a tower exists at position
-bool hasTowerAt(int gridX, int gridY) {
-    for (int i = 0; i < towerCount; i++) {
-        if (towers[i].active && towers[i].gridX == gridX && towers[i].gridY == gridY) {
-            return true;
-        }
+CellRect visibleCells(const GameWorld& world, int margin) {
+    Vector2 topLeft = camera.target;
+    Vector2 bottomRight = { topLeft.x + VIEWPORT.width / camera.zoom, topLeft.y + VIEWPORT.height / camera.zoom };
+    CellRect cells;
+    cells.minX = (int)floorf((topLeft.x - GRID_OFFSET_X) / CELL_SIZE) - margin;
+    cells.minY = (int)floorf((topLeft.y - GRID_OFFSET_Y) / CELL_SIZE) - margin;
+    cells.maxX = (int)floorf((bottomRight.x - GRID_OFFSET_X) / CELL_SIZE) + margin;
+    cells.maxY = (int)floorf((bottomRight.y - GRID_OFFSET_Y) / CELL_SIZE) + margin;
+    if (cells.minX < 0) cells.minX = 0;
+    if (cells.minY < 0) cells.minY = 0;
+    if (cells.maxX >= world.gridWidth) cells.maxX = world.gridWidth - 1;
+    if (cells.maxY >= world.gridHeight) cells.maxY = world.gridHeight - 1;
+    return cells;
+}
+
+// Is a world position on screen (give or take `margin` world units)?
+bool isInView(float x, float y, float margin) {
+    float left = camera.target.x - margin;
+    float top = camera.target.y - margin;
+    return x >= left && y >= top
+           && x <= left + VIEWPORT.width / camera.zoom + 2 * margin
+           && y <= top + VIEWPORT.height / camera.zoom + 2 * margin;
+}
+
+// Arrow keys scroll, the mouse wheel zooms around the mouse pointer.
+// Returns true if the view changed.
+bool updateCamera(const GameWorld& world) {
+    if (!mapScrolls(world)) return false;
+    
+    Camera2D before = camera;
+    float step = CAMERA_PAN_SPEED * GetFrameTime() / camera.zoom;
+    if (IsKeyDown(KEY_LEFT)) camera.target.x -= step;
+    if (IsKeyDown(KEY_RIGHT)) camera.target.x += step;
+    if (IsKeyDown(KEY_UP)) camera.target.y -= step;
+    if (IsKeyDown(KEY_DOWN)) camera.target.y += step;
+    
+    float wheel = GetMouseWheelMove();
+    Vector2 mouse = GetMousePosition();
+    if (wheel != 0 && CheckCollisionPointRec(mouse, VIEWPORT)) {
+        Vector2 anchor = GetScreenToWorld2D(mouse, camera);
+        camera.zoom *= (wheel > 0) ? 1.25f : 0.8f;
+        clampCamera(world);
+        Vector2 moved = GetScreenToWorld2D(mouse, camera);
+        camera.target.x += anchor.x - moved.x;
+        camera.target.y += anchor.y - moved.y;
     }
-    return false;
+    clampCamera(world);
+    
+    return camera.target.x != before.target.x || camera.target.y != before.target.y || camera.zoom != before.zoom;
 }
 
-// Check if position is the base
-bool isBasePosition(int gridX, int gridY) {
-    return gridX == GRID_SIZE - 1 && (gridY == 4 || gridY == 5);
+// Everything between these is drawn in world coordinates
+void beginWorldView(const GameWorld& world) {
+    if (mapScrolls(world)) BeginScissorMode((int)VIEWPORT.x, (int)VIEWPORT.y, (int)VIEWPORT.width, (int)VIEWPORT.height);
+    BeginMode2D(camera);
 }
 
-// Calculate distance between two points
-double calculateDistance(float x1, float y1, float x2, float y2) {
-    float dx = x2 - x1;
-    float dy = y2 - y1;
-    return sqrt(dx * dx + dy * dy);
+void endWorldView(const GameWorld& world) {
+    EndMode2D();
+    if (mapScrolls(world)) EndScissorMode();
 }
 
-// Set status message
-void setMessage(const std::string& msg) {
-    statusMessage = msg;
-    messageTimer = 3.0f;
+// Slots of the towers on chunks near the viewport (chunk by chunk)
+std::vector<int> visibleTowers;
+
+void collectVisibleTowers(const GameWorld& world) {
+    visibleTowers.clear();
+    CellRect view = visibleCells(world, TOWER_VIEW_MARGIN);
+    for (int cy = view.minY / GRID_CHUNK_SIZE; cy <= view.maxY / GRID_CHUNK_SIZE; cy++) {
+        for (int cx = view.minX / GRID_CHUNK_SIZE; cx <= view.maxX / GRID_CHUNK_SIZE; cx++) {
+            const GridChunk& chunk = world.gridChunks[cy * world.chunksX + cx];
+            visibleTowers.insert(visibleTowers.end(), chunk.towers.begin(), chunk.towers.end());
+        }
+    }
 }
 
 // ═══════════════════════════════════════════════════════════════════════
-// CUSTOM FONT DRAWING HELPER
+// HELPER FUNCTIONS
 // ═══════════════════════════════════════════════════════════════════════
-// Draws text using the custom font with proper spacing
 
-void DrawTextCustom(const char* text, int x, int y, int fontSize, Color color) {
-    if (fontLoaded) {
-        Vector2 pos = { (float)x, (float)y };
-        DrawTextEx(gameFont, text, pos, (float)fontSize, 1.0f, color);
-    } else {
-        DrawText(text, x, y, fontSize, color);
+// Convert grid coordinates to pixels (world pixels, see beginWorldView)
+Vector2 gridToScreen(int gridX, int gridY) {
+    SimPoint p = gridToWorld(gridX, gridY);
+    return { p.x, p.y };
+}
+
+// Convert screen pixels to grid coordinates (through the camera)
+void screenToGrid(const GameWorld& world, int screenX, int screenY, int* gridX, int* gridY) {
+    Vector2 point = { (float)screenX, (float)screenY };
+    if (mapScrolls(world) && !CheckCollisionPointRec(point, VIEWPORT)) {
+        *gridX = -1;  // Hidden parts of the map cannot be clicked
+        *gridY = -1;
+        return;
     }
+    Vector2 mapPoint = GetScreenToWorld2D(point, camera);
+    *gridX = (int)floorf((mapPoint.x - GRID_OFFSET_X) / CELL_SIZE);
+    *gridY = (int)floorf((mapPoint.y - GRID_OFFSET_Y) / CELL_SIZE);
 }
 
 // ═══════════════════════════════════════════════════════════════════════
-// RADAR HELPER - Convert game enemies to Radar format
+// CUSTOM FONT DRAWING HELPER
 // ═══════════════════════════════════════════════════════════════════════
-// This creates data that can be passed to student's 04_Radar.cpp functions
+// Draws text using the custom font with proper spacing.
+// The layout of every (text, size) pair is worked out once - the same
+// glyph positions DrawTextEx would compute - and kept in a cache. After
+// that, drawing the text only sends its glyph quads to rlgl in one go.
 
-std::vector<RadarEnemy> getRadarEnemies() {
-    std::vector<RadarEnemy> radarList;
+struct GlyphQuad {
+    float x0, y0, x1, y1;       // Position, relative to the text origin
+    float u0, v0, u1, v1;       // Texture coordinates in the font atlas
+};
+
+struct TextRun {
+    std::vector<GlyphQuad> quads;
+};
+
+const size_t TEXT_CACHE_LIMIT = 512;   // Runs kept before the cache starts over
+
+std::unordered_map<std::string, TextRun> textCache;
+std::string textCacheKey;              // Reused, so lookups do not allocate
+
+void clearTextCache() {
+    textCache.clear();
+}
+
+// Same glyph placement as DrawTextEx/DrawTextCodepoint in raylib 5.0
+void layoutTextRun(TextRun& run, Font font, const char* text, float fontSize, float spacing) {
+    float scale = fontSize / (float)font.baseSize;
+    float padding = (float)font.glyphPadding;
+    float offsetX = 0;
+    
+    int length = (int)strlen(text);
+    for (int i = 0; i < length; ) {
+        int bytes = 0;
+        int codepoint = GetCodepointNext(&text[i], &bytes);
+        int index = GetGlyphIndex(font, codepoint);
+        i += bytes;
+        
+        Rectangle rec = font.recs[index];
+        GlyphInfo glyph = font.glyphs[index];
+        if (codepoint != ' ' && codepoint != '\t') {
+            GlyphQuad quad;
+            quad.x0 = offsetX + (glyph.offsetX - padding) * scale;
+            quad.y0 = (glyph.offsetY - padding) * scale;
+            quad.x1 = quad.x0 + (rec.width + 2 * padding) * scale;
+            quad.y1 = quad.y0 + (rec.height + 2 * padding) * scale;
+            quad.u0 = (rec.x - padding) / font.texture.width;
+            quad.v0 = (rec.y - padding) / font.texture.height;
+            quad.u1 = (rec.x + rec.width + padding) / font.texture.width;
+            quad.v1 = (rec.y + rec.height + padding) / font.texture.height;
+            run.quads.push_back(quad);
+        }
+        offsetX += ((glyph.advanceX == 0) ? rec.width : glyph.advanceX) * scale + spacing;
+    }
+}
+
+void DrawTextCustom(const char* text, int x, int y, int fontSize, Color color) {
+    // DrawText() uses the default font with a minimum size and wider spacing
+    Font font = fontLoaded ? gameFont : GetFontDefault();
+    if (!fontLoaded && fontSize < 10) fontSize = 10;
+    float spacing = fontLoaded ? 1.0f : (float)(fontSize / 10);
+    
+    // Multi-line text is rare - let Raylib handle the line breaks
+    if (strchr(text, '\n') != nullptr) {
+        DrawTextEx(font, text, (Vector2){ (float)x, (float)y }, (float)fontSize, spacing, color);
+        return;
+    }
     
-    // Base position for distance calculation
-    float baseX = GRID_OFFSET_X + (GRID_SIZE - 1) * CELL_SIZE;
+    textCacheKey.assign(text);
+    textCacheKey.push_back('\0');
+    textCacheKey.push_back((char)fontSize);
+    auto found = textCache.find(textCacheKey);
+    if (found == textCache.end()) {
+        if (textCache.size() >= TEXT_CACHE_LIMIT) clearTextCache();  // Old scores, timers...
+        found = textCache.emplace(textCacheKey, TextRun()).first;
+        layoutTextRun(found->second, font, text, (float)fontSize, spacing);
+    }
     
-    for (int i = 0; i < MAX_ENEMIES; i++) {
-        if (!enemies[i].alive) continue;
-        
-        RadarEnemy re;
-        re.distance = (baseX - enemies[i].x) / CELL_SIZE;  // Distance to base in grid units
-        re.health = enemies[i].health;
-        re.isFlying = false;  // Regular enemies don't fly (could be expanded later!)
-        radarList.push_back(re);
+    const std::vector<GlyphQuad>& quads = found->second.quads;
+    if (quads.empty()) return;
+    
+    rlCheckRenderBatchLimit(4 * (int)quads.size());
+    rlSetTexture(font.texture.id);
+    rlBegin(RL_QUADS);
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+    for (const GlyphQuad& quad : quads) {
+        float x0 = x + quad.x0, y0 = y + quad.y0;
+        float x1 = x + quad.x1, y1 = y + quad.y1;
+        rlTexCoord2f(quad.u0, quad.v0); rlVertex2f(x0, y0);
+        rlTexCoord2f(quad.u0, quad.v1); rlVertex2f(x0, y1);
+        rlTexCoord2f(quad.u1, quad.v1); rlVertex2f(x1, y1);
+        rlTexCoord2f(quad.u1, quad.v0); rlVertex2f(x1, y0);
     }
-    return radarList;
+    rlEnd();
+    rlSetTexture(0);
 }
 
 // ═══════════════════════════════════════════════════════════════════════
-// UPGRADE HELPER - Convert game towers to Upgrade format
+// SPRITE ATLAS
 // ═══════════════════════════════════════════════════════════════════════
-// This creates data that can be passed to student's 05_Upgrades.cpp functions
+// Every enemy, tower and projectile look is drawn ONCE at startup into a
+// single texture. Each frame the entities are then drawn as textured
+// quads from that texture, which Raylib puts into one rlgl batch (one
+// draw call) instead of building every circle and line from scratch.
+// Moving parts (spikes, cannons, trails) are baked at angle 0 and
+// rotated when drawn; pulsing parts are baked opaque and faded by tint.
 
-std::vector<UpgradeTower> getUpgradeTowers() {
-    std::vector<UpgradeTower> upgradeList;
-    
-    for (int i = 0; i < MAX_TOWERS; i++) {
-        if (!towers[i].active) continue;
-        
-        UpgradeTower ut;
-        ut.level = towers[i].level;
-        ut.damage = getTowerBaseDamage();
-        ut.range = getTowerRange();
-        ut.type = towers[i].type;
-        ut.kills = towers[i].kills;
-        upgradeList.push_back(ut);
-    }
-    return upgradeList;
+enum SpriteId {
+    SPRITE_ENEMY_GLOW, SPRITE_ENEMY_BODY, SPRITE_ENEMY_SPIKES,
+    SPRITE_BAR_BACK, SPRITE_BAR_FILL,
+    SPRITE_TOWER_LASER, SPRITE_TOWER_MISSILE, SPRITE_TOWER_PLASMA,
+    SPRITE_CANNON_LASER, SPRITE_CANNON_MISSILE, SPRITE_CANNON_PLASMA,
+    SPRITE_TOWER_CORE,
+    SPRITE_PROJECTILE_TRAIL, SPRITE_PROJECTILE_HEAD,
+    SPRITE_COUNT
+};
+
+struct Sprite {
+    Rectangle source;   // Area in the atlas
+    Vector2 pivot;      // Point placed at the draw position (and rotated around)
+};
+
+const int ATLAS_CELL = 48;      // Every sprite gets its own cell...
+const int ATLAS_PADDING = 2;    // ...with a gap so filtering never bleeds
+const int ATLAS_COLUMNS = 8;
+const int CANNON_BAKE_LENGTH = 16;
+
+Sprite sprites[SPRITE_COUNT];
+Texture2D spriteAtlas = { 0 };
+
+// Tower colors per type (body, shadow)
+void getTowerColors(const std::string& type, Color* color, Color* dark) {
+    *color = COLOR_TOWER;
+    *dark = COLOR_TOWER_DARK;
+    if (type == "missile") { *color = ORANGE; *dark = (Color){180, 100, 30, 255}; }
+    else if (type == "plasma") { *color = PURPLE; *dark = (Color){100, 50, 150, 255}; }
+}
+
+// The atlas holds premultiplied alpha, so tints must be premultiplied too
+Color premultiply(Color c) {
+    return (Color){ (unsigned char)(c.r * c.a / 255), (unsigned char)(c.g * c.a / 255),
+                    (unsigned char)(c.b * c.a / 255), c.a };
 }
 
-UpgradePlayer getUpgradePlayer() {
-    UpgradePlayer up;
-    up.name = getCommanderName();
-    up.money = playerMoney;
-    up.totalKills = totalPlayerKills;
-    up.wavesCompleted = wave - 1;
-    up.isPremium = false;  // Could be toggled with a key!
-    return up;
+// Blend so a texture drawn on BLANK ends up with premultiplied alpha:
+// layered semi-transparent shapes then look the same as when drawn
+// directly. Close with EndBlendMode(); draw the result with
+// BLEND_ALPHA_PREMULTIPLY.
+void beginPremultipliedBake() {
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                              RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+}
+
+// Draw the look of one sprite with its cell's top-left corner at (x, y)
+void bakeSprite(SpriteId id, float x, float y) {
+    float cx = x + ATLAS_CELL / 2;
+    float cy = y + ATLAS_CELL / 2;
+    Rectangle cell = { x, y, (float)ATLAS_CELL, (float)ATLAS_CELL };
+    Vector2 center = { (float)(ATLAS_CELL / 2), (float)(ATLAS_CELL / 2) };
+    Color towerColor, towerDark;
+
+    switch (id) {
+        case SPRITE_ENEMY_GLOW:
+            DrawCircle((int)cx, (int)cy, 22, COLOR_ENEMY);
+            sprites[id] = { cell, center };
+            break;
+        case SPRITE_ENEMY_BODY:
+            DrawCircle((int)cx + 2, (int)cy + 2, 16, Fade(BLACK, 0.4f));  // Shadow
+            DrawCircle((int)cx, (int)cy, 16, COLOR_ENEMY_DARK);
+            DrawCircle((int)cx, (int)cy, 12, COLOR_ENEMY);
+            DrawCircle((int)cx, (int)cy, 6, Fade(BLACK, 0.5f));          // Evil eye
+            DrawCircle((int)cx + 2, (int)cy - 1, 3, Fade(WHITE, 0.9f));
+            sprites[id] = { cell, center };
+            break;
+        case SPRITE_ENEMY_SPIKES:
+            for (int s = 0; s < 3; s++) {
+                float a = s * 2.094f;  // 120 degrees apart
+                Vector2 p1 = {cx + cosf(a) * 14, cy + sinf(a) * 14};
+                Vector2 p2 = {cx + cosf(a - 0.3f) * 8, cy + sinf(a - 0.3f) * 8};
+                Vector2 p3 = {cx + cosf(a + 0.3f) * 8, cy + sinf(a + 0.3f) * 8};
+                DrawTriangle(p1, p2, p3, COLOR_ENEMY);
+            }
+            sprites[id] = { cell, center };
+            break;
+        case SPRITE_BAR_BACK:
+            DrawRectangleRounded((Rectangle){x, y, 32, 6}, 0.5f, 4, Fade(BLACK, 0.7f));
+            sprites[id] = { (Rectangle){x, y, 32, 6}, (Vector2){0, 0} };
+            break;
+        case SPRITE_BAR_FILL:
+            DrawRectangleRounded((Rectangle){x, y, 30, 4}, 0.5f, 4, WHITE);
+            sprites[id] = { (Rectangle){x, y, 30, 4}, (Vector2){0, 0} };
+            break;
+        case SPRITE_TOWER_LASER:
+        case SPRITE_TOWER_MISSILE:
+        case SPRITE_TOWER_PLASMA:
+            getTowerColors(id == SPRITE_TOWER_MISSILE ? "missile" : id == SPRITE_TOWER_PLASMA ? "plasma" : "laser",
+                           &towerColor, &towerDark);
+            DrawCircle((int)cx, (int)cy + 5, 18, Fade(BLACK, 0.5f));  // Shadow
+            DrawCircle((int)cx, (int)cy, 18, towerDark);
+            DrawCircle((int)cx, (int)cy, 14, towerColor);
+            DrawCircle((int)cx, (int)cy, 8, Fade(WHITE, 0.3f));       // Highlight
+            sprites[id] = { cell, center };
+            break;
+        case SPRITE_CANNON_LASER:
+        case SPRITE_CANNON_MISSILE:
+        case SPRITE_CANNON_PLASMA:
+            getTowerColors(id == SPRITE_CANNON_MISSILE ? "missile" : id == SPRITE_CANNON_PLASMA ? "plasma" : "laser",
+                           &towerColor, &towerDark);
+            DrawLineEx((Vector2){x, y + 3}, (Vector2){x + CANNON_BAKE_LENGTH, y + 3}, 6, towerDark);
+            DrawLineEx((Vector2){x, y + 3}, (Vector2){x + CANNON_BAKE_LENGTH, y + 3}, 3, towerColor);
+            sprites[id] = { (Rectangle){x, y, (float)CANNON_BAKE_LENGTH, 6}, (Vector2){0, 3} };
+            break;
+        case SPRITE_TOWER_CORE:
+            DrawCircle((int)cx, (int)cy, 4, WHITE);
+            sprites[id] = { cell, center };
+            break;
+        case SPRITE_PROJECTILE_TRAIL:
+            // Glow layer, core beam, bright center; pivot at the head end
+            DrawLineEx((Vector2){x, y + 4}, (Vector2){x + 15, y + 4}, 8, COLOR_PROJECTILE_GLOW);
+            DrawLineEx((Vector2){x, y + 4}, (Vector2){x + 15, y + 4}, 3, COLOR_PROJECTILE);
+            DrawLineEx((Vector2){x, y + 4}, (Vector2){x + 15, y + 4}, 1, WHITE);
+            sprites[id] = { (Rectangle){x, y, 15, 8}, (Vector2){15, 4} };
+            break;
+        case SPRITE_PROJECTILE_HEAD:
+            DrawCircle((int)cx, (int)cy, 6, COLOR_PROJECTILE_GLOW);
+            DrawCircle((int)cx, (int)cy, 3, COLOR_PROJECTILE);
+            DrawCircle((int)cx, (int)cy, 1, WHITE);
+            sprites[id] = { cell, center };
+            break;
+        default:
+            break;
+    }
+}
+
+// Needs an open window (GPU context)
+void loadSpriteAtlas() {
+    int pitch = ATLAS_CELL + ATLAS_PADDING;
+    int rows = (SPRITE_COUNT + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS;
+    RenderTexture2D target = LoadRenderTexture(ATLAS_COLUMNS * pitch, rows * pitch);
+
+    BeginTextureMode(target);
+    ClearBackground(BLANK);
+    beginPremultipliedBake();
+    for (int i = 0; i < SPRITE_COUNT; i++) {
+        bakeSprite((SpriteId)i, (float)((i % ATLAS_COLUMNS) * pitch), (float)((i / ATLAS_COLUMNS) * pitch));
+    }
+    EndBlendMode();
+    EndTextureMode();
+
+    // Render textures are stored upside down; flip once so that the
+    // sprite rectangles above can be used as they are
+    Image image = LoadImageFromTexture(target.texture);
+    ImageFlipVertical(&image);
+    spriteAtlas = LoadTextureFromImage(image);
+    SetTextureFilter(spriteAtlas, TEXTURE_FILTER_BILINEAR);
+    UnloadImage(image);
+    UnloadRenderTexture(target);
+}
+
+void unloadSpriteAtlas() {
+    UnloadTexture(spriteAtlas);
+}
+
+// Draw a sprite with its pivot at (x, y). scaleX stretches it along its
+// own x axis (cannon length, health bar fill). Call between
+// BeginBlendMode(BLEND_ALPHA_PREMULTIPLY) and EndBlendMode().
+void drawSprite(SpriteId id, float x, float y, float rotation, float scaleX, Color tint) {
+    const Sprite& sprite = sprites[id];
+    Rectangle dest = { x, y, sprite.source.width * scaleX, sprite.source.height };
+    Vector2 origin = { sprite.pivot.x * scaleX, sprite.pivot.y };
+    DrawTexturePro(spriteAtlas, sprite.source, dest, origin, rotation, premultiply(tint));
 }
 
 // ═══════════════════════════════════════════════════════════════════════
-// GAME INITIALIZATION
+// BACKGROUND LAYER
 // ═══════════════════════════════════════════════════════════════════════
+// Everything behind the game that does not move (grid dots, grid border,
+// HQ) is drawn once into a transparent render texture and copied over
+// the stars each frame. The stars twinkle in a small shader: each star
+// pixel of the star layer stores brightness (r), twinkle phase (g) and
+// size factor (b), and the shader turns that into a white pixel.
+// The layers are rebuilt only when invalidated (new starfield, resize).
 
-void initStars() {
-    for (int i = 0; i < NUM_STARS; i++) {
-        stars[i].x = (float)(rand() % SCREEN_WIDTH);
-        stars[i].y = (float)(rand() % SCREEN_HEIGHT);
-        stars[i].brightness = 0.3f + (float)(rand() % 70) / 100.0f;
+const char* STAR_TWINKLE_SHADER =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform float time;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    vec4 star = texture(texture0, fragTexCoord);\n"
+    "    if (star.a == 0.0) discard;\n"
+    "    float twinkle = min(star.r + 0.1 * sin(time * 2.0 + star.g * 6.2831853), 1.0);\n"
+    "    finalColor = vec4(1.0, 1.0, 1.0, clamp(twinkle, 0.0, 1.0) * star.b);\n"
+    "}\n";
+
+RenderTexture2D backgroundLayer = { 0 };
+RenderTexture2D starLayer = { 0 };
+Shader starShader = { 0 };
+int starTimeLoc = -1;
+bool twinkleShaderReady = false;
+bool backgroundValid = false;
+
+// Call after anything shown in the background changed
+void invalidateBackground() {
+    backgroundValid = false;
+}
+
+// Needs an open window (GPU context)
+void loadBackground() {
+    starShader = LoadShaderFromMemory(0, STAR_TWINKLE_SHADER);
+    twinkleShaderReady = (starShader.id != rlGetShaderIdDefault());
+    if (twinkleShaderReady) starTimeLoc = GetShaderLocation(starShader, "time");
+    backgroundValid = false;
+}
+
+void unloadBackground() {
+    if (backgroundLayer.id != 0) UnloadRenderTexture(backgroundLayer);
+    if (starLayer.id != 0) UnloadRenderTexture(starLayer);
+    if (twinkleShaderReady) UnloadShader(starShader);
+}
+
+// Star pixel for the twinkle shader; without the shader the star is
+// drawn into the background layer at its base brightness
+void bakeStarPixel(int x, int y, float brightness, int index, float size) {
+    if (twinkleShaderReady) {
+        float phase = fmodf((float)index, 2 * PI) / (2 * PI);
+        DrawPixel(x, y, (Color){ (unsigned char)(brightness * 255), (unsigned char)(phase * 255),
+                                 (unsigned char)(size * 255), 255 });
+    } else {
+        DrawPixel(x, y, Fade(WHITE, brightness * size));
     }
 }
 
-void initGame() {
-    // Initialize starfield
-    initStars();
-    
-    // *** CALLING STUDENT'S FUNCTIONS from 01_Economy.cpp ***
-    // These values come from the student's code!
-    playerMoney = getStartingMoney();
-    baseHealth = getBaseHealth();
-    
-    score = 0;
-    wave = 1;
-    towerCount = 0;
-    enemyCount = 0;
-    enemySpawnTimer = 2.0f;
-    gameOver = false;
-    gamePaused = false;
+void bakeBackground(const GameWorld& world) {
+    int width = GetScreenWidth();
+    int height = GetScreenHeight();
+    if (backgroundLayer.id == 0 || backgroundLayer.texture.width != width || backgroundLayer.texture.height != height) {
+        if (backgroundLayer.id != 0) UnloadRenderTexture(backgroundLayer);
+        if (starLayer.id != 0) UnloadRenderTexture(starLayer);
+        backgroundLayer = LoadRenderTexture(width, height);
+        starLayer = LoadRenderTexture(width, height);
+    }
     
-    // Clear towers
-    for (int i = 0; i < MAX_TOWERS; i++) {
-        towers[i].active = false;
-        towers[i].kills = 0;
-        towers[i].level = 1;
-        towers[i].type = "laser";
+    // Stars go first (data for the twinkle shader, or plain pixels)
+    if (twinkleShaderReady) {
+        BeginTextureMode(starLayer);
+        ClearBackground(BLANK);
+    } else {
+        BeginTextureMode(backgroundLayer);
+        ClearBackground(BLANK);
+        beginPremultipliedBake();
+    }
+    for (int i = 0; i < NUM_STARS; i++) {
+        bakeStarPixel((int)stars[i].x, (int)stars[i].y, stars[i].brightness, i, 1.0f);
+        // Some stars are bigger
+        if (stars[i].brightness > 0.7f) {
+            bakeStarPixel((int)stars[i].x + 1, (int)stars[i].y, stars[i].brightness, i, 0.5f);
+        }
+    }
+    if (twinkleShaderReady) {
+        EndTextureMode();
+        BeginTextureMode(backgroundLayer);
+        ClearBackground(BLANK);
+        beginPremultipliedBake();
     }
     
-    // Reset total kills
-    totalPlayerKills = 0;
+    // The map part is seen through the camera (only the visible cells)
+    beginWorldView(world);
     
-    // Clear enemies
-    for (int i = 0; i < MAX_ENEMIES; i++) {
-        enemies[i].alive = false;
+    // Subtle grid dots at corners
+    if (CELL_SIZE * camera.zoom >= GRID_DOT_MIN_PIXELS) {
+        CellRect view = visibleCells(world, 1);
+        for (int y = view.minY; y <= view.maxY; y++) {
+            for (int x = view.minX; x <= view.maxX; x++) {
+                DrawCircle(GRID_OFFSET_X + x * CELL_SIZE, GRID_OFFSET_Y + y * CELL_SIZE, 2, Fade(COLOR_GRID, 0.5f));
+            }
+        }
     }
+    // Grid border
+    DrawRectangleLinesEx((Rectangle){GRID_OFFSET_X - 2, GRID_OFFSET_Y - 2, 
+                         (float)(world.gridWidth * CELL_SIZE + 4), (float)(world.gridHeight * CELL_SIZE + 4)}, 2, Fade(COLOR_GRID, 0.8f));
     
-    // Clear projectiles
-    for (int i = 0; i < MAX_PROJECTILES; i++) {
-        projectiles[i].active = false;
-    }
+    // Base body with gradient effect (layered rectangles)
+    int baseScreenX = GRID_OFFSET_X + (world.gridWidth - 1) * CELL_SIZE;
+    int baseScreenY = GRID_OFFSET_Y + getBaseRow(world) * CELL_SIZE;
+    DrawRectangle(baseScreenX + 3, baseScreenY + 3, CELL_SIZE - 6, CELL_SIZE * 2 - 6, COLOR_BASE);
+    DrawRectangle(baseScreenX + 8, baseScreenY + 8, CELL_SIZE - 16, CELL_SIZE * 2 - 16, 
+                  Fade(WHITE, 0.2f));
+    DrawRectangleLinesEx((Rectangle){(float)baseScreenX + 3, (float)baseScreenY + 3, 
+                         CELL_SIZE - 6, CELL_SIZE * 2 - 6}, 2, Fade(WHITE, 0.5f));
     
-    // Reset UI state
-    selectedTowerIndex = -1;
-    showUpgradePanel = false;
+    // Base icon (shield shape)
+    Vector2 shieldCenter = {(float)baseScreenX + CELL_SIZE/2, (float)baseScreenY + CELL_SIZE};
+    DrawCircle((int)shieldCenter.x, (int)shieldCenter.y - 10, 12, Fade(WHITE, 0.3f));
+    DrawText("HQ", baseScreenX + 14, baseScreenY + CELL_SIZE - 8, 18, WHITE);
+    endWorldView(world);
+    EndBlendMode();
+    EndTextureMode();
     
-    // *** CALLING STUDENT'S FUNCTION: getCommanderName() ***
-    setMessage("Welcome, " + getCommanderName() + "! Click to place towers.");
+    backgroundValid = true;
 }
 
-// Spawn a new enemy
-void spawnEnemy() {
-    for (int i = 0; i < MAX_ENEMIES; i++) {
-        if (!enemies[i].alive) {
-            enemies[i].x = (float)GRID_OFFSET_X;
-            enemies[i].y = (float)(GRID_OFFSET_Y + (3 + (wave % 5)) * CELL_SIZE + CELL_SIZE / 2);
-            enemies[i].health = 50 + wave * 10;
-            enemies[i].speed = 30.0f + wave * 2.0f;
-            enemies[i].alive = true;
-            enemyCount++;
-            return;
-        }
+// Replaces ClearBackground(): twinkling stars, then the cached layer
+void drawBackground(const GameWorld& world) {
+    if (IsWindowResized()) invalidateBackground();
+    if (!backgroundValid) bakeBackground(world);
+    
+    ClearBackground(COLOR_BACKGROUND);
+    
+    // Render textures are stored upside down, hence the negative height
+    Rectangle source = { 0, 0, (float)backgroundLayer.texture.width, -(float)backgroundLayer.texture.height };
+    
+    if (twinkleShaderReady) {
+        float time = (float)GetTime();
+        SetShaderValue(starShader, starTimeLoc, &time, SHADER_UNIFORM_FLOAT);
+        BeginShaderMode(starShader);
+        DrawTextureRec(starLayer.texture, source, (Vector2){ 0, 0 }, WHITE);
+        EndShaderMode();
     }
+    
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTextureRec(backgroundLayer.texture, source, (Vector2){ 0, 0 }, WHITE);
+    EndBlendMode();
 }
 
-// Fire a projectile from tower to enemy
-void fireProjectile(float fromX, float fromY, float toX, float toY) {
-    for (int i = 0; i < MAX_PROJECTILES; i++) {
-        if (!projectiles[i].active) {
-            projectiles[i].x = fromX;
-            projectiles[i].y = fromY;
-            projectiles[i].targetX = toX;
-            projectiles[i].targetY = toY;
-            projectiles[i].speed = 500.0f;
-            projectiles[i].active = true;
-            return;
-        }
+// ═══════════════════════════════════════════════════════════════════════
+// RETAINED HUD PANELS
+// ═══════════════════════════════════════════════════════════════════════
+// The RADAR, STATUS and COMMANDER panels each keep their own texture.
+// Every frame only their inputs are compared with the last ones; the
+// student functions and TextFormat run again only when something they
+// depend on changed. Pulsing labels are drawn on top every frame.
+
+struct HudPanel {
+    Rectangle bounds;           // Screen area, including the outline
+    RenderTexture2D texture;
+    bool valid;
+};
+
+const float HUD_PANEL_MARGIN = 2;   // Room for the outline around a panel
+
+HudPanel radarPanel = { {560, 50, 230, 170}, { 0 }, false };
+HudPanel statusPanel = { {560, 230, 230, 90}, { 0 }, false };
+HudPanel commanderPanel = { {560, 330, 230, 175}, { 0 }, false };
+
+// Everything the panels show depends only on these values
+struct RadarPanelInputs {
+    int total, close, totalHealth, strongest;
+    int nearestBand;            // Color of the nearest distance (-1 = none)
+    char nearest[16];           // Nearest distance as it is printed
+};
+
+struct StatusPanelInputs {
+    int score, wave;
+};
+
+struct CommanderPanelInputs {
+    int money, kills, wave;
+    int towerCount;
+    uint32_t towerHash;         // FNV-1a of the level, kills and type of each active tower
+};
+
+RadarPanelInputs radarPanelInputs;
+StatusPanelInputs statusPanelInputs;
+CommanderPanelInputs commanderPanelInputs;
+bool statusIsVIP = false;       // Last results, for the pulsing labels
+bool statusIsWeekend = false;
+
+bool operator==(const RadarPanelInputs& a, const RadarPanelInputs& b) {
+    return a.total == b.total && a.close == b.close && a.totalHealth == b.totalHealth
+           && a.strongest == b.strongest && a.nearestBand == b.nearestBand
+           && strcmp(a.nearest, b.nearest) == 0;
+}
+
+// Start drawing into a panel's texture, using the same screen coordinates
+// as when drawing the panel directly
+void beginHudPanel(HudPanel& panel) {
+    int width = (int)(panel.bounds.width + 2 * HUD_PANEL_MARGIN);
+    int height = (int)(panel.bounds.height + 2 * HUD_PANEL_MARGIN);
+    if (panel.texture.id == 0) panel.texture = LoadRenderTexture(width, height);
+    
+    BeginTextureMode(panel.texture);
+    ClearBackground(BLANK);
+    beginPremultipliedBake();
+    
+    Camera2D camera = { 0 };
+    camera.target = (Vector2){ panel.bounds.x - HUD_PANEL_MARGIN, panel.bounds.y - HUD_PANEL_MARGIN };
+    camera.zoom = 1.0f;
+    BeginMode2D(camera);
+}
+
+void endHudPanel(HudPanel& panel) {
+    EndMode2D();
+    EndBlendMode();
+    EndTextureMode();
+    panel.valid = true;
+}
+
+void drawHudPanel(const HudPanel& panel) {
+    Rectangle source = { 0, 0, (float)panel.texture.texture.width, -(float)panel.texture.texture.height };
+    Vector2 position = { panel.bounds.x - HUD_PANEL_MARGIN, panel.bounds.y - HUD_PANEL_MARGIN };
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTextureRec(panel.texture.texture, source, position, WHITE);
+    EndBlendMode();
+}
+
+void unloadHudPanels() {
+    HudPanel* panels[] = { &radarPanel, &statusPanel, &commanderPanel };
+    for (HudPanel* panel : panels) {
+        if (panel->texture.id != 0) UnloadRenderTexture(panel->texture);
+        panel->texture.id = 0;
+        panel->valid = false;
     }
 }
 
-// ═══════════════════════════════════════════════════════════════════════
-// GAME UPDATE
-// ═══════════════════════════════════════════════════════════════════════
+// ─────────────────────────────────────────────────────────────────────
+// RADAR PANEL (right side, below wave indicator) - ENLARGED
+// ─────────────────────────────────────────────────────────────────────
+void updateRadarPanel(GameWorld& world) {
+    // Worked out once per tick by the student's 04_Radar.cpp functions
+    const RadarStats& radar = getRadarStats(world);
+    
+    RadarPanelInputs inputs;
+    inputs.total = radar.total;
+    inputs.close = radar.close;
+    inputs.totalHealth = radar.totalHealth;
+    inputs.strongest = radar.strongest;
+    if (radar.closest >= 0 && radar.closest < 9999) {
+        inputs.nearestBand = (radar.closest < 3) ? 0 : (radar.closest < 6) ? 1 : 2;
+        snprintf(inputs.nearest, sizeof(inputs.nearest), "%.1f", radar.closest);
+    } else {
+        inputs.nearestBand = -1;
+        strcpy(inputs.nearest, "---");
+    }
+    if (radarPanel.valid && inputs == radarPanelInputs) return;
+    radarPanelInputs = inputs;
+    
+    beginHudPanel(radarPanel);
+    
+    // Panel: X=560, width=230 (fills right side)
+    DrawRectangleRounded((Rectangle){560, 50, 230, 170}, 0.1f, 8, Fade(BLACK, 0.85f));
+    DrawRoundedRectLines((Rectangle){560, 50, 230, 170}, 0.1f, 8, 2, Fade(YELLOW, 0.7f));
+    DrawTextCustom("RADAR", 580, 58, 24, YELLOW);
+    
+    // *** STUDENT'S FUNCTION: countAllEnemies() from 04_Radar.cpp ***
+    int totalEnemies = radar.total;
+    DrawTextCustom(TextFormat("Enemies: %d", totalEnemies), 575, 90, 20, COLOR_UI_TEXT);
+    
+    // *** STUDENT'S FUNCTION: countCloseEnemies() from 04_Radar.cpp ***
+    int closeEnemies = radar.close;
+    Color closeColor = (closeEnemies > 2) ? RED : (closeEnemies > 0) ? ORANGE : GREEN;
+    DrawTextCustom(TextFormat("Close: %d", closeEnemies), 575, 115, 20, closeColor);
+    
+    // *** STUDENT'S FUNCTION: getTotalEnemyHealth() from 04_Radar.cpp ***
+    int totalHP = radar.totalHealth;
+    DrawTextCustom(TextFormat("Total HP: %d", totalHP), 575, 140, 20, COLOR_ENEMY);
+    
+    // *** STUDENT'S FUNCTION: findClosestEnemy() from 04_Radar.cpp ***
+    if (inputs.nearestBand >= 0) {
+        Color distColor = (inputs.nearestBand == 0) ? RED : (inputs.nearestBand == 1) ? ORANGE : GREEN;
+        DrawTextCustom(TextFormat("Nearest: %s", inputs.nearest), 575, 165, 20, distColor);
+    } else {
+        DrawTextCustom("Nearest: ---", 575, 165, 20, GREEN);
+    }
+    
+    // *** STUDENT'S FUNCTION: findStrongestEnemy() from 04_Radar.cpp ***
+    int strongestHP = radar.strongest;
+    if (strongestHP > 0) {
+        Color hpColor = (strongestHP > 100) ? RED : (strongestHP > 50) ? ORANGE : COLOR_UI_TEXT;
+        DrawTextCustom(TextFormat("Max HP: %d", strongestHP), 575, 190, 20, hpColor);
+    } else {
+        DrawTextCustom("Max HP: ---", 575, 190, 20, GREEN);
+    }
+    
+    endHudPanel(radarPanel);
+}
 
-void updateGame(float deltaTime) {
-    if (gamePaused || gameOver) return;
+// ─────────────────────────────────────────────────────────────────────
+// STATUS PANEL (right side, below RADAR) - ENLARGED
+// Shows VIP & Weekend from 02_Shop.cpp
+// ─────────────────────────────────────────────────────────────────────
+void updateStatusPanel(const GameWorld& world) {
+    StatusPanelInputs inputs = { world.score, world.wave };
+    if (statusPanel.valid && inputs.score == statusPanelInputs.score && inputs.wave == statusPanelInputs.wave) return;
+    statusPanelInputs = inputs;
+    
+    beginHudPanel(statusPanel);
+    
+    DrawRectangleRounded((Rectangle){560, 230, 230, 90}, 0.1f, 8, Fade(BLACK, 0.85f));
+    DrawRoundedRectLines((Rectangle){560, 230, 230, 90}, 0.1f, 8, 2, Fade(SKYBLUE, 0.7f));
+    DrawTextCustom("STATUS", 580, 238, 22, SKYBLUE);
     
-    // Update message timer
-    if (messageTimer > 0) {
-        messageTimer -= deltaTime;
+    // *** CALLING STUDENT'S FUNCTION: isVIPPlayer() from 02_Shop.cpp ***
+    statusIsVIP = isVIPPlayer(world.score, world.wave, false);  // score, wavesCompleted, hasPremium
+    if (!statusIsVIP) {
+        DrawTextCustom("VIP: ---", 575, 268, 20, GRAY);
     }
     
-    // Spawn enemies
-    enemySpawnTimer -= deltaTime;
-    if (enemySpawnTimer <= 0) {
-        spawnEnemy();
-        enemySpawnTimer = 3.0f - (wave * 0.1f);  // Faster spawns each wave
-        if (enemySpawnTimer < 1.0f) enemySpawnTimer = 1.0f;
+    // *** CALLING STUDENT'S FUNCTION: calculateDiscount() from 02_Shop.cpp ***
+    // Simulate weekend based on wave number (every 5 waves = "weekend sale")
+    statusIsWeekend = (world.wave % 5 == 0 && world.wave > 0);
+    int discount = calculateDiscount(world.score, statusIsWeekend);  // using score as "purchases"
+    
+    if (discount > 0) {
+        DrawTextCustom(TextFormat("Discount: -%d%%", discount), 575, 295, 20, GREEN);
+    } else {
+        DrawTextCustom("Discount: ---", 575, 295, 18, GRAY);
     }
     
-    // Update enemies
-    for (int i = 0; i < MAX_ENEMIES; i++) {
-        if (!enemies[i].alive) continue;
-        
-        // Move enemy toward base
-        enemies[i].x += enemies[i].speed * deltaTime;
-        
-        // Check if enemy reached base
-        float baseX = GRID_OFFSET_X + (GRID_SIZE - 1) * CELL_SIZE;
-        if (enemies[i].x >= baseX) {
-            enemies[i].alive = false;
-            enemyCount--;
-            baseHealth -= 20;
-            setMessage("ALERT: Enemy breached defenses! -20 HP");
-            
-            if (baseHealth <= 0) {
-                gameOver = true;
-                setMessage("GAME OVER - Base Destroyed!");
-            }
-        }
+    endHudPanel(statusPanel);
+}
+
+// Pulsing labels of the STATUS panel (drawn every frame)
+void drawStatusPanelLabels() {
+    if (statusIsVIP) {
+        float pulse = 0.7f + 0.3f * sinf(GetTime() * 3);
+        DrawTextCustom("VIP", 575, 268, 22, Fade(GOLD, pulse));
+    }
+    if (statusIsWeekend) {
+        float pulse = 0.6f + 0.4f * sinf(GetTime() * 4);
+        DrawTextCustom("WKND", 680, 268, 20, Fade(MAGENTA, pulse));
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────
+// COMMANDER PANEL (right side, below STATUS) - ENLARGED
+// ─────────────────────────────────────────────────────────────────────
+void updateCommanderPanel(const GameWorld& world) {
+    CommanderPanelInputs inputs;
+    inputs.money = world.playerMoney;
+    inputs.kills = world.totalPlayerKills;
+    inputs.wave = world.wave;
+    inputs.towerCount = 0;
+    inputs.towerHash = 2166136261u;
+    for (int i = 0; i < world.towers.capacity(); i++) {
+        if (!world.towers[i].active) continue;
+        int type = (world.towers[i].type == "laser") ? 0 : (world.towers[i].type == "missile") ? 1 :
+                   (world.towers[i].type == "plasma") ? 2 : 3;
+        int values[3] = { world.towers[i].level, world.towers[i].kills, type };
+        for (int v : values) inputs.towerHash = (inputs.towerHash ^ (uint32_t)v) * 16777619u;
+        inputs.towerCount++;
     }
+    if (commanderPanel.valid && inputs.money == commanderPanelInputs.money && inputs.kills == commanderPanelInputs.kills
+        && inputs.wave == commanderPanelInputs.wave && inputs.towerCount == commanderPanelInputs.towerCount
+        && inputs.towerHash == commanderPanelInputs.towerHash) return;
+    commanderPanelInputs = inputs;
     
-    // Update towers - check for enemies in range
-    for (int t = 0; t < MAX_TOWERS; t++) {
-        if (!towers[t].active) continue;
-        
-        // *** CALLING STUDENT'S FUNCTION: calculateFireRate() from 03_Targeting.cpp ***
-        // Fire rate based on upgrade level (simulated as tower index for variety)
-        int upgradeLevel = t % 3;  // 0, 1, or 2
-        int fireRateMs = calculateFireRate(500, upgradeLevel);  // Base 500ms
-        float cooldownTime = fireRateMs / 1000.0f;  // Convert to seconds
-        
-        // Cooldown
-        if (towers[t].cooldown > 0) {
-            towers[t].cooldown -= deltaTime;
-            continue;
-        }
-        
-        Vector2 towerPos = gridToScreen(towers[t].gridX, towers[t].gridY);
-        
-        // *** CALLING STUDENT'S FUNCTION: getTowerRange() from 01_Economy.cpp ***
-        double towerRange = getTowerRange();
-        
-        // *** CALLING STUDENT'S FUNCTION: calculateGridDistance() from 03_Targeting.cpp ***
-        // Find up to 3 enemies and their distances for selectTarget()
-        double enemy1Dist = 9999, enemy2Dist = 9999, enemy3Dist = 9999;
-        int enemy1Idx = -1, enemy2Idx = -1, enemy3Idx = -1;
-        int foundCount = 0;
-        
-        for (int e = 0; e < MAX_ENEMIES && foundCount < 3; e++) {
-            if (!enemies[e].alive) continue;
-            
-            // Use student's calculateGridDistance for pixel-to-grid conversion
-            double gridDist = calculateGridDistance(
-                towers[t].gridX, towers[t].gridY,
-                (int)((enemies[e].x - GRID_OFFSET_X) / CELL_SIZE),
-                (int)((enemies[e].y - GRID_OFFSET_Y) / CELL_SIZE)
-            );
-            
-            // Fallback if student hasn't implemented it yet
-            if (gridDist == 0.0) {
-                double dx = towerPos.x - enemies[e].x;
-                double dy = towerPos.y - enemies[e].y;
-                gridDist = sqrt(dx*dx + dy*dy) / CELL_SIZE;
-            }
-            
-            if (foundCount == 0) { enemy1Dist = gridDist; enemy1Idx = e; }
-            else if (foundCount == 1) { enemy2Dist = gridDist; enemy2Idx = e; }
-            else if (foundCount == 2) { enemy3Dist = gridDist; enemy3Idx = e; }
-            foundCount++;
-        }
-        
-        if (foundCount == 0) continue;  // No enemies
-        
-        // *** CALLING STUDENT'S FUNCTION: selectTarget() from 03_Targeting.cpp ***
-        int targetNum = selectTarget(enemy1Dist, enemy2Dist, enemy3Dist);
-        int targetIdx = (targetNum == 1) ? enemy1Idx : (targetNum == 2) ? enemy2Idx : enemy3Idx;
-        if (targetIdx < 0) targetIdx = enemy1Idx;  // Fallback
-        
-        double dist = calculateDistance(towerPos.x, towerPos.y, enemies[targetIdx].x, enemies[targetIdx].y);
-        
-        // *** CALLING STUDENT'S FUNCTION: isEnemyInRange() from 03_Targeting.cpp ***
-        bool inRange = isEnemyInRange(dist / CELL_SIZE, towerRange);
-        
-        if (inRange) {
-            // *** CALLING STUDENT'S FUNCTIONS from 01_Economy.cpp and 03_Targeting.cpp ***
-            int baseDamage = getTowerBaseDamage();
-            int damage = calculateDamage(baseDamage, TOWER_LEVEL);
-            
-            // *** CALLING STUDENT'S FUNCTION: calculateBonusDamage() from 03_Targeting.cpp ***
-            // Extra damage for weak enemies!
-            int bonusDmg = calculateBonusDamage(baseDamage, enemies[targetIdx].health, TOWER_LEVEL);
-            if (bonusDmg > damage) damage = bonusDmg;  // Use bonus if student implemented it
-            
-            // *** CALLING STUDENT'S FUNCTION: calculateTotalDamage() from 03_Targeting.cpp ***
-            // Random critical hit (1 in 5 chance)
-            int critMultiplier = (rand() % 5 == 0) ? 2 : 1;
-            int totalDmg = calculateTotalDamage(baseDamage, TOWER_LEVEL, critMultiplier);
-            if (totalDmg > 0 && critMultiplier == 2) {
-                damage = totalDmg;  // Use crit damage if student implemented it
-            }
-            
-            // *** CALLING STUDENT'S FUNCTION: predictEnemyPosition() from 03_Targeting.cpp ***
-            // Lead the shot! Predict where enemy will be
-            float projectileTime = dist / 500.0f;  // Time for projectile to reach
-            double predictedX = predictEnemyPosition(enemies[targetIdx].x, enemies[targetIdx].speed, projectileTime);
-            
-            // Fire projectile (use predicted position if student implemented it, otherwise current)
-            float targetX = (predictedX != enemies[targetIdx].x) ? (float)predictedX : enemies[targetIdx].x;
-            fireProjectile(towerPos.x, towerPos.y, targetX, enemies[targetIdx].y);
-            
-            // Apply damage
-            enemies[targetIdx].health -= damage;
-            
-            if (enemies[targetIdx].health <= 0) {
-                enemies[targetIdx].alive = false;
-                enemyCount--;
-                score += 50;
-                
-                // *** Track kills for upgrade system ***
-                towers[t].kills++;
-                totalPlayerKills++;
-                
-                // *** CALLING STUDENT'S FUNCTION: getKillBonus() from 01_Economy.cpp ***
-                playerMoney += getKillBonus();
-                
-                // Check for wave completion
-                if (enemyCount <= 0) {
-                    wave++;
-                    // *** CALLING STUDENT'S FUNCTION: getWaveBonus() from 01_Economy.cpp ***
-                    playerMoney += getWaveBonus(wave);
-                    setMessage("Wave " + std::to_string(wave) + " incoming! Bonus: $" + std::to_string(getWaveBonus(wave)));
-                }
-            }
-            
-            towers[t].cooldown = cooldownTime;  // Use calculated fire rate!
-            // Don't break - tower has done its job for this frame
-        }
+    std::vector<UpgradeTower> upgradeData = getUpgradeTowers(world);
+    UpgradePlayer playerData = getUpgradePlayer(world);
+    
+    beginHudPanel(commanderPanel);
+    
+    DrawRectangleRounded((Rectangle){560, 330, 230, 175}, 0.1f, 8, Fade(BLACK, 0.85f));
+    DrawRoundedRectLines((Rectangle){560, 330, 230, 175}, 0.1f, 8, 2, Fade(PURPLE, 0.7f));
+    DrawTextCustom("COMMANDER", 580, 338, 22, PURPLE);
+    
+    // *** CALLING STUDENT'S FUNCTION: getPlayerRank() from 05_Upgrades.cpp ***
+    std::string playerRank = getPlayerRank(playerData);
+    Color rankColor = (playerRank == "Θρύλος") ? GOLD : 
+                      (playerRank == "Ήρωας") ? PURPLE :
+                      (playerRank == "Βετεράνος") ? ORANGE :
+                      (playerRank == "Μαθητευόμενος") ? COLOR_TOWER : GRAY;
+    DrawTextCustom(playerRank.c_str(), 575, 368, 24, rankColor);
+    DrawTextCustom(TextFormat("Kills: %d", world.totalPlayerKills), 575, 398, 20, COLOR_UI_TEXT);
+    
+    // *** CALLING STUDENT'S FUNCTION: getTotalFleetDamage() from 05_Upgrades.cpp ***
+    int fleetDamage = getTotalFleetDamage(upgradeData);
+    DrawTextCustom(TextFormat("Fleet DMG: %d", fleetDamage), 575, 425, 18, COLOR_ENEMY);
+    
+    // *** CALLING STUDENT'S FUNCTION: findMVPTower() from 05_Upgrades.cpp ***
+    int mvpIdx = findMVPTower(upgradeData);
+    if (mvpIdx >= 0 && mvpIdx < (int)upgradeData.size()) {
+        DrawTextCustom(TextFormat("MVP: %s", upgradeData[mvpIdx].type.c_str()), 575, 450, 18, GOLD);
+    } else {
+        DrawTextCustom("MVP: ---", 575, 450, 18, GRAY);
     }
     
-    // Update projectiles
-    for (int i = 0; i < MAX_PROJECTILES; i++) {
-        if (!projectiles[i].active) continue;
-        
-        float dx = projectiles[i].targetX - projectiles[i].x;
-        float dy = projectiles[i].targetY - projectiles[i].y;
-        float dist = sqrt(dx * dx + dy * dy);
-        
-        if (dist < 10) {
-            projectiles[i].active = false;
-        } else {
-            projectiles[i].x += (dx / dist) * projectiles[i].speed * deltaTime;
-            projectiles[i].y += (dy / dist) * projectiles[i].speed * deltaTime;
-        }
+    // *** CALLING STUDENT'S FUNCTION: recommendTower() from 05_Upgrades.cpp ***
+    bool hasAir = false;
+    std::string recommended = recommendTower(world.playerMoney, hasAir, world.wave);
+    Color recColor = (recommended == "plasma") ? PURPLE : 
+                     (recommended == "missile") ? ORANGE :
+                     (recommended == "laser") ? COLOR_TOWER : GRAY;
+    DrawTextCustom(TextFormat("Recommend: %s", recommended.c_str()), 575, 477, 18, recColor);
+    
+    endHudPanel(commanderPanel);
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// GAME INITIALIZATION
+// ═══════════════════════════════════════════════════════════════════════
+
+// Stars use their own random stream so drawing never changes the game
+void initStars(uint64_t seed) {
+    SimRng starRng;
+    seedRng(starRng, seed ^ 0x5374617273ULL);
+    for (int i = 0; i < NUM_STARS; i++) {
+        stars[i].x = (float)rngRange(starRng, SCREEN_WIDTH);
+        stars[i].y = (float)rngRange(starRng, SCREEN_HEIGHT);
+        stars[i].brightness = 0.3f + (float)rngRange(starRng, 70) / 100.0f;
+    }
+}
+
+// New starfield + cleared selection for the game that was just started
+void resetView(const GameWorld& world) {
+    initStars(world.gameSeed);
+    resetCamera(world);
+    invalidateBackground();
+
+    // Reset UI state
+    selectedTowerIndex = -1;
+    showUpgradePanel = false;
+    hintCellX = -1;
+    hintCellY = -1;
+    hintSearching = false;
+}
+
+// Restart as a recorded command, so replays restart at the same tick
+void restartGame(GameWorld& world) {
+    issueCommand(world, CMD_RESTART);
+    resetView(world);
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// CHECKPOINT
+// ═══════════════════════════════════════════════════════════════════════
+// [F5] keeps a save state of the game in memory, [F9] rewinds to it.
+// A rewind cannot be recorded as a command, so it is off while recording.
+// The checkpoint is also written to CHECKPOINT_FILE, so the headless and
+// balance runners can play it on (--load).
+const char* CHECKPOINT_FILE = "checkpoint.sav";
+std::vector<unsigned char> checkpoint;   // Empty = no checkpoint yet
+
+void saveCheckpoint(GameWorld& world) {
+    checkpoint.resize(getSaveStateSize(world));   // Only allocates when the game grew
+    writeSaveState(world, checkpoint.data(), checkpoint.size());
+    if (saveStateFile(CHECKPOINT_FILE, world)) {
+        setMessage(world, TextFormat("Checkpoint saved to %s! Press F9 to rewind.", CHECKPOINT_FILE));
+    } else {
+        setMessage(world, "Checkpoint saved! Press F9 to rewind.");
+    }
+}
+
+void loadCheckpoint(GameWorld& world) {
+    if (isRecording()) {
+        setMessage(world, "Rewind is off while recording a session");
+    } else if (checkpoint.empty()) {
+        setMessage(world, "No checkpoint yet - press F5 to save one");
+    } else if (readSaveState(world, checkpoint.data(), checkpoint.size())) {
+        resetView(world);
+        setMessage(world, "Rewound to the checkpoint");
+    } else {
+        setMessage(world, "Checkpoint is damaged - the game goes on");
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// HINTS
+// ═══════════════════════════════════════════════════════════════════════
+// [H] plays the next WHAT_IF_SECONDS from here for the best few cells
+// (forks of the game, see WhatIf.h) and marks the cell that ends best.
+// The branches play WHAT_IF_TICKS_PER_FRAME ticks a frame on the job
+// threads, so the game runs on while the hint is worked out. Only the
+// status message of the live game changes, so hints are fine while
+// recording.
+void startHintSearch(GameWorld& world, TowerHintSearch& search) {
+    hintCellX = -1;
+    hintCellY = -1;
+    hintSearching = startTowerHint(search, world, WHAT_IF_SECONDS, WHAT_IF_CANDIDATES);
+    setMessage(world, hintSearching ? "HINT: looking ahead..." : "HINT: no tower can be built right now");
+}
+
+// Once a frame: play the search on and show the hint when it has ended
+void updateHintSearch(GameWorld& world, TowerHintSearch& search) {
+    if (!hintSearching || !stepTowerHint(search, WHAT_IF_TICKS_PER_FRAME)) return;
+    hintSearching = false;
+
+    WhatIfResult best;
+    if (getTowerHint(search, hintCellX, hintCellY, best)) {
+        setMessage(world, TextFormat("HINT: build at (%d, %d) - in %d s the HQ has %d HP, %d kills",
+                                     hintCellX, hintCellY, (int)WHAT_IF_SECONDS, best.baseHealth, best.kills));
     }
 }
 
@@ -540,14 +1047,17 @@ void updateGame(float deltaTime) {
 // INPUT HANDLING
 // ═══════════════════════════════════════════════════════════════════════
 
-void handleInput() {
+void handleInput(GameWorld& world, TowerHintSearch& hintSearch) {
+    // The cached background shows the map through the camera
+    if (updateCamera(world)) invalidateBackground();
+    
     // Get mouse position
     int mouseX = GetMouseX();
     int mouseY = GetMouseY();
     
     // Update hovered cell
-    screenToGrid(mouseX, mouseY, &hoveredCellX, &hoveredCellY);
-    if (!isValidGridPos(hoveredCellX, hoveredCellY)) {
+    screenToGrid(world, mouseX, mouseY, &hoveredCellX, &hoveredCellY);
+    if (!isValidGridPos(world, hoveredCellX, hoveredCellY)) {
         hoveredCellX = -1;
         hoveredCellY = -1;
     }
@@ -559,160 +1069,39 @@ void handleInput() {
     
     // Check if clicked on RESTART button
     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mousePos, btnRestart)) {
-        initGame();
+        restartGame(world);
         return;  // Don't process other clicks
     }
     
     // Check if clicked on AUTO-UPGRADE button
-    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mousePos, btnAutoUpgrade) && !gameOver) {
-        // Build upgrade tower list from current towers
-        std::vector<UpgradeTower> upgradeList;
-        for (int i = 0; i < MAX_TOWERS; i++) {
-            if (!towers[i].active) continue;
-            UpgradeTower ut;
-            ut.level = towers[i].level;
-            ut.damage = getTowerBaseDamage();
-            ut.range = getTowerRange();
-            ut.type = towers[i].type;
-            ut.kills = towers[i].kills;
-            upgradeList.push_back(ut);
-        }
-        
-        int originalMoney = playerMoney;
-        int remainingMoney = autoUpgradeAll(upgradeList, playerMoney);
-        int spent = originalMoney - remainingMoney;
-        
-        // Apply upgrades back to actual towers
-        int upgradeIdx = 0;
-        int upgradesApplied = 0;
-        for (int i = 0; i < MAX_TOWERS && upgradeIdx < (int)upgradeList.size(); i++) {
-            if (!towers[i].active) continue;
-            if (upgradeList[upgradeIdx].level > towers[i].level) {
-                towers[i].level = upgradeList[upgradeIdx].level;
-                upgradesApplied++;
-            }
-            upgradeIdx++;
-        }
-        
-        playerMoney = remainingMoney;
-        
-        if (upgradesApplied > 0) {
-            setMessage("AUTO-UPGRADE: " + std::to_string(upgradesApplied) + " towers upgraded! Spent $" + std::to_string(spent));
-        } else if (spent == 0) {
-            setMessage("AUTO-UPGRADE: No upgrades possible (solve exercises first!)");
-        }
+    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(mousePos, btnAutoUpgrade) && !world.gameOver) {
+        issueCommand(world, CMD_AUTO_UPGRADE);
         return;
     }
     
     // Check if clicked on UPGRADE TOWER button (when tower selected)
     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && showUpgradePanel && selectedTowerIndex >= 0 
-        && CheckCollisionPointRec(mousePos, btnUpgradeTower) && !gameOver) {
-        
-        Tower& selTower = towers[selectedTowerIndex];
-        UpgradeTower ut;
-        ut.level = selTower.level;
-        ut.damage = getTowerBaseDamage();
-        ut.range = getTowerRange();
-        ut.type = selTower.type;
-        ut.kills = selTower.kills;
-        
-        // *** CALLING STUDENT'S FUNCTION: canUpgrade() from 05_Upgrades.cpp ***
-        if (canUpgrade(ut, playerMoney)) {
-            // *** CALLING STUDENT'S FUNCTION: getUpgradeCost() from 05_Upgrades.cpp ***
-            int cost = getUpgradeCost(ut);
-            playerMoney -= cost;
-            selTower.level++;
-            
-            // *** CALLING STUDENT'S FUNCTIONS: getUpgradedDamage/Range() ***
-            int newDmg = getUpgradedDamage(ut);
-            double newRange = getUpgradedRange(ut);
-            
-            setMessage(selTower.type + " upgraded to Lv" + std::to_string(selTower.level) + "! DMG: " + std::to_string(newDmg));
-        } else {
-            // *** CALLING STUDENT'S FUNCTION: getUpgradeCost() from 05_Upgrades.cpp ***
-            int cost = getUpgradeCost(ut);
-            if (selTower.level >= 5) {
-                setMessage("Tower already at MAX LEVEL!");
-            } else {
-                setMessage("Need $" + std::to_string(cost) + " to upgrade (solve exercises!)");
-            }
-        }
+        && CheckCollisionPointRec(mousePos, btnUpgradeTower) && !world.gameOver) {
+        const Tower& selTower = world.towers[selectedTowerIndex];
+        issueCommand(world, CMD_UPGRADE_TOWER, selTower.gridX, selTower.gridY);
         return;
     }
     
     // Handle mouse click - place tower OR select tower
-    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && !gameOver) {
-        if (isValidGridPos(hoveredCellX, hoveredCellY)) {
+    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && !world.gameOver) {
+        if (isValidGridPos(world, hoveredCellX, hoveredCellY)) {
             // First check if clicking on existing tower to SELECT it
-            bool clickedOnTower = false;
-            for (int i = 0; i < MAX_TOWERS; i++) {
-                if (towers[i].active && towers[i].gridX == hoveredCellX && towers[i].gridY == hoveredCellY) {
-                    selectedTowerIndex = i;
-                    showUpgradePanel = true;
-                    clickedOnTower = true;
-                    setMessage("Tower selected! Click UPGRADE button or Right-Click");
-                    break;
-                }
-            }
-            
-            if (!clickedOnTower) {
+            int clickedTower = towerIndexAt(world, hoveredCellX, hoveredCellY);
+            if (clickedTower >= 0) {
+                selectedTowerIndex = clickedTower;
+                showUpgradePanel = true;
+                setMessage(world, "Tower selected! Click UPGRADE button or Right-Click");
+            } else {
                 // Deselect tower if clicking elsewhere
                 selectedTowerIndex = -1;
                 showUpgradePanel = false;
                 
-                // Check if position is valid (not base, not occupied)
-                if (isBasePosition(hoveredCellX, hoveredCellY)) {
-                    setMessage("Cannot build on the base!");
-                }
-                else if (hasTowerAt(hoveredCellX, hoveredCellY)) {
-                    // This shouldn't happen since we check above, but safety
-                    setMessage("Position occupied!");
-                }
-                else {
-                    // *** CALLING STUDENT'S FUNCTIONS from 01_Economy.cpp and 02_Shop.cpp ***
-                    int towerCost = getTowerCost();
-                    bool canBuy = canAffordTower(playerMoney, towerCost);
-                    bool cellEmpty = !hasTowerAt(hoveredCellX, hoveredCellY);
-                    
-                    // *** CALLING STUDENT'S FUNCTION: canBuildTowerAt() from 02_Shop.cpp ***
-                    bool canBuild = canBuildTowerAt(hoveredCellX, hoveredCellY, cellEmpty);
-                    
-                    // *** CALLING STUDENT'S FUNCTION: shouldShowWarning() from 02_Shop.cpp ***
-                    bool showWarn = shouldShowWarning(canBuy, towerCount < MAX_TOWERS);
-                    
-                    if (canBuy && towerCount < MAX_TOWERS) {
-                        // Place tower
-                        for (int i = 0; i < MAX_TOWERS; i++) {
-                            if (!towers[i].active) {
-                                towers[i].gridX = hoveredCellX;
-                                towers[i].gridY = hoveredCellY;
-                                towers[i].cooldown = 0;
-                                towers[i].active = true;
-                                towers[i].kills = 0;
-                                towers[i].level = 1;
-                                
-                                // *** CALLING STUDENT'S FUNCTION: recommendTower() from 05_Upgrades.cpp ***
-                                bool hasAirEnemies = false;  // Could be expanded for flying enemies!
-                                std::string recType = recommendTower(playerMoney, hasAirEnemies, wave);
-                                towers[i].type = (recType == "none") ? "laser" : recType;
-                                
-                                towerCount++;
-                                playerMoney -= towerCost;
-                                
-                                // *** CALLING STUDENT'S FUNCTION: getTowerType() from 02_Shop.cpp ***
-                                int tType = getTowerType(playerMoney);
-                                std::string typeStr = (tType == 3) ? "SUPER" : (tType == 2) ? "ADVANCED" : (tType == 1) ? "BASIC" : "NONE";
-                                setMessage("Tower (" + towers[i].type + ") deployed! Next: " + typeStr);
-                                break;
-                            }
-                        }
-                    } else if (showWarn) {
-                        // Warning from student's function!
-                        setMessage("WARNING: Not enough credits or no slots!");
-                    } else {
-                        setMessage("Not enough credits! Need $" + std::to_string(towerCost));
-                    }
-                }
+                issueCommand(world, CMD_BUILD_TOWER, hoveredCellX, hoveredCellY);
             }
         } else {
             // Clicked outside grid - deselect tower
@@ -722,124 +1111,96 @@ void handleInput() {
     }
     
     // *** RIGHT-CLICK to upgrade existing tower ***
-    if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON) && !gameOver) {
-        if (isValidGridPos(hoveredCellX, hoveredCellY)) {
-            // Find tower at this position
-            for (int i = 0; i < MAX_TOWERS; i++) {
-                if (towers[i].active && 
-                    towers[i].gridX == hoveredCellX && 
-                    towers[i].gridY == hoveredCellY) {
-                    
-                    // Create upgrade tower data
-                    UpgradeTower ut;
-                    ut.level = towers[i].level;
-                    ut.damage = getTowerBaseDamage();
-                    ut.range = getTowerRange();
-                    ut.type = towers[i].type;
-                    ut.kills = towers[i].kills;
-                    
-                    // *** CALLING STUDENT'S FUNCTION: canUpgrade() from 05_Upgrades.cpp ***
-                    if (canUpgrade(ut, playerMoney)) {
-                        // *** CALLING STUDENT'S FUNCTION: getUpgradeCost() from 05_Upgrades.cpp ***
-                        int cost = getUpgradeCost(ut);
-                        playerMoney -= cost;
-                        towers[i].level++;
-                        
-                        // *** CALLING STUDENT'S FUNCTIONS: getUpgradedDamage/Range() ***
-                        int newDmg = getUpgradedDamage(ut);
-                        double newRange = getUpgradedRange(ut);
-                        
-                        setMessage(towers[i].type + " upgraded to Lv" + std::to_string(towers[i].level) + 
-                                   "! DMG: " + std::to_string(newDmg));
-                    } else {
-                        // *** CALLING STUDENT'S FUNCTION: getUpgradeCost() from 05_Upgrades.cpp ***
-                        int cost = getUpgradeCost(ut);
-                        if (towers[i].level >= 5) {
-                            setMessage("Tower already at MAX LEVEL!");
-                        } else {
-                            setMessage("Need $" + std::to_string(cost) + " to upgrade!");
-                        }
-                    }
-                    break;
-                }
-            }
+    if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON) && !world.gameOver) {
+        if (hasTowerAt(world, hoveredCellX, hoveredCellY)) {
+            issueCommand(world, CMD_UPGRADE_TOWER, hoveredCellX, hoveredCellY);
         }
     }
     
     // Keyboard shortcuts (also work via buttons now)
     if (IsKeyPressed(KEY_SPACE)) {
-        gamePaused = !gamePaused;
+        issueCommand(world, CMD_TOGGLE_PAUSE);
     }
     if (IsKeyPressed(KEY_R)) {
-        initGame();
+        restartGame(world);
     }
-    if (IsKeyPressed(KEY_U) && !gameOver) {
+    if (IsKeyPressed(KEY_U) && !world.gameOver) {
         // Same logic as button - trigger auto-upgrade
-        std::vector<UpgradeTower> upgradeList;
-        for (int i = 0; i < MAX_TOWERS; i++) {
-            if (!towers[i].active) continue;
-            UpgradeTower ut;
-            ut.level = towers[i].level;
-            ut.damage = getTowerBaseDamage();
-            ut.range = getTowerRange();
-            ut.type = towers[i].type;
-            ut.kills = towers[i].kills;
-            upgradeList.push_back(ut);
-        }
-        int originalMoney = playerMoney;
-        int remainingMoney = autoUpgradeAll(upgradeList, playerMoney);
-        int spent = originalMoney - remainingMoney;
-        int upgradeIdx = 0;
-        int upgradesApplied = 0;
-        for (int i = 0; i < MAX_TOWERS && upgradeIdx < (int)upgradeList.size(); i++) {
-            if (!towers[i].active) continue;
-            if (upgradeList[upgradeIdx].level > towers[i].level) {
-                towers[i].level = upgradeList[upgradeIdx].level;
-                upgradesApplied++;
-            }
-            upgradeIdx++;
-        }
-        playerMoney = remainingMoney;
-        if (upgradesApplied > 0) {
-            setMessage("AUTO-UPGRADE: " + std::to_string(upgradesApplied) + " towers upgraded!");
-        } else {
-            setMessage("AUTO-UPGRADE: Solve exercises first!");
-        }
+        issueCommand(world, CMD_AUTO_UPGRADE);
     }
     if (IsKeyPressed(KEY_ESCAPE)) {
         selectedTowerIndex = -1;
         showUpgradePanel = false;
     }
+    if (IsKeyPressed(KEY_F5)) {
+        saveCheckpoint(world);
+    }
+    if (IsKeyPressed(KEY_F9)) {
+        loadCheckpoint(world);
+    }
+    if (IsKeyPressed(KEY_H)) {
+        startHintSearch(world, hintSearch);
+    }
+    if (IsKeyPressed(KEY_E)) {
+        showExercisePanel = !showExercisePanel;
+    }
 }
 
 // ═══════════════════════════════════════════════════════════════════════
 // RENDERING
 // ═══════════════════════════════════════════════════════════════════════
 
-void drawGame() {
+// ─────────────────────────────────────────────────────────────────────
+// EXERCISE PANEL [E] - what the startup probes found (see Exercises.h)
+// ─────────────────────────────────────────────────────────────────────
+struct ExerciseFile {
+    const char* name;
+    Exercise first;   // Its exercises run up to the first one of the next file
+};
+
+const ExerciseFile exerciseFiles[] = {
+    { "01_Economy.cpp", EX_STARTING_MONEY },
+    { "02_Shop.cpp", EX_CAN_AFFORD_TOWER },
+    { "03_Targeting.cpp", EX_ENEMY_IN_RANGE },
+    { "04_Radar.cpp", EX_COUNT_ALL_ENEMIES },
+    { "05_Upgrades.cpp", EX_UPGRADE_COST },
+};
+const int EXERCISE_FILE_COUNT = sizeof(exerciseFiles) / sizeof(exerciseFiles[0]);
+
+void drawExercisePanel() {
+    Rectangle panel = { 20, 60, (float)(SCREEN_WIDTH - 40), 470 };
+    DrawRectangleRounded(panel, 0.05f, 8, Fade(BLACK, 0.92f));
+    DrawRoundedRectLines(panel, 0.05f, 8, 2, COLOR_TOWER);
+    DrawTextCustom(TextFormat("EXERCISES: %d / %d solved", countSolvedExercises(), (int)EXERCISE_COUNT),
+                   40, 72, 20, COLOR_TOWER);
+    DrawTextCustom("[E] Close", SCREEN_WIDTH - 110, 76, 14, GRAY);
+
+    // Three files on the first row, two on the second
+    for (int f = 0; f < EXERCISE_FILE_COUNT; f++) {
+        int x = 40 + (f % 3) * 250;
+        int y = 108 + (f / 3) * 205;
+        int last = (f + 1 < EXERCISE_FILE_COUNT) ? exerciseFiles[f + 1].first : EXERCISE_COUNT;
+        DrawTextCustom(exerciseFiles[f].name, x, y, 16, COLOR_UI_TEXT);
+        for (int e = exerciseFiles[f].first; e < last; e++) {
+            bool solved = isExerciseSolved((Exercise)e);
+            DrawTextCustom(TextFormat("%s %s", solved ? "[x]" : "[ ]", getExerciseName((Exercise)e)),
+                           x, y + 24 + (e - exerciseFiles[f].first) * 16, 14, solved ? GREEN : GRAY);
+        }
+    }
+}
+
+void drawGame(GameWorld& world) {
     BeginDrawing();
-    ClearBackground(COLOR_BACKGROUND);
-    
     // ─────────────────────────────────────────────────────────────────
-    // Draw Starfield Background
+    // Draw Background (cached starfield, grid dots, border and HQ)
     // ─────────────────────────────────────────────────────────────────
-    for (int i = 0; i < NUM_STARS; i++) {
-        // Twinkle effect
-        float twinkle = stars[i].brightness + 0.1f * sinf(GetTime() * 2.0f + i);
-        if (twinkle > 1.0f) twinkle = 1.0f;
-        Color starColor = Fade(WHITE, twinkle);
-        DrawPixel((int)stars[i].x, (int)stars[i].y, starColor);
-        // Some stars are bigger
-        if (stars[i].brightness > 0.7f) {
-            DrawPixel((int)stars[i].x + 1, (int)stars[i].y, Fade(WHITE, twinkle * 0.5f));
-        }
-    }
+    drawBackground(world);
     
     // ─────────────────────────────────────────────────────────────────
     // Draw Header / HUD with sleek panels
     // ─────────────────────────────────────────────────────────────────
     // Pre-calculate some values for display
-    int wavePointsSum = countdownSum(wave);
+    int wavePointsSum = countdownSum(world.wave);
     
     // Title with glow
     DrawTextCustom("PLANETARY DEFENSE", 22, 12, 22, Fade(COLOR_TOWER, 0.3f));
@@ -848,30 +1209,30 @@ void drawGame() {
     // Wave indicator (top right)
     DrawRectangleRounded((Rectangle){(float)(SCREEN_WIDTH - 120), 8, 110, 32}, 0.3f, 8, Fade(COLOR_BASE, 0.2f));
     DrawRoundedRectLines((Rectangle){(float)(SCREEN_WIDTH - 120), 8, 110, 32}, 0.3f, 8, 1, Fade(COLOR_BASE, 0.5f));
-    DrawTextCustom(TextFormat("WAVE %d", wave), SCREEN_WIDTH - 100, 14, 22, COLOR_BASE);
+    DrawTextCustom(TextFormat("WAVE %d", world.wave), SCREEN_WIDTH - 100, 14, 22, COLOR_BASE);
     
     // Stats bar (horizontal strip below title)
     // Money (taller to show build type)
     DrawRectangleRounded((Rectangle){20, 42, 150, 45}, 0.2f, 8, Fade(BLACK, 0.6f));
     DrawRoundedRectLines((Rectangle){20, 42, 150, 45}, 0.2f, 8, 1, Fade(COLOR_MONEY, 0.4f));
-    DrawTextCustom(TextFormat("$ %d", playerMoney), 32, 48, 24, COLOR_MONEY);
+    DrawTextCustom(TextFormat("$ %d", world.playerMoney), 32, 48, 24, COLOR_MONEY);
     
     // Health bar
     DrawRectangleRounded((Rectangle){180, 42, 170, 45}, 0.2f, 8, Fade(BLACK, 0.6f));
     DrawRoundedRectLines((Rectangle){180, 42, 170, 45}, 0.2f, 8, 1, Fade(COLOR_HEALTH, 0.4f));
     DrawTextCustom("HP", 190, 50, 18, COLOR_HEALTH);
     DrawRectangleRounded((Rectangle){220, 52, 100, 12}, 0.3f, 4, Fade(RED, 0.3f));
-    DrawRectangleRounded((Rectangle){220, 52, (float)baseHealth, 12}, 0.3f, 4, COLOR_HEALTH);
-    DrawTextCustom(TextFormat("%d%%", baseHealth), 328, 50, 18, COLOR_HEALTH);
+    DrawRectangleRounded((Rectangle){220, 52, (float)world.baseHealth, 12}, 0.3f, 4, COLOR_HEALTH);
+    DrawTextCustom(TextFormat("%d%%", world.baseHealth), 328, 50, 18, COLOR_HEALTH);
     
     // Score (wider panel)
     DrawRectangleRounded((Rectangle){360, 42, 160, 45}, 0.2f, 8, Fade(BLACK, 0.6f));
     DrawRoundedRectLines((Rectangle){360, 42, 160, 45}, 0.2f, 8, 1, Fade(WHITE, 0.3f));
-    DrawTextCustom(TextFormat("SCORE: %d", score), 375, 48, 20, COLOR_UI_TEXT);
+    DrawTextCustom(TextFormat("SCORE: %d", world.score), 375, 48, 20, COLOR_UI_TEXT);
     DrawTextCustom(TextFormat("Wave Pts: %d", wavePointsSum), 375, 70, 14, Fade(COLOR_UI_TEXT, 0.6f));
     
     // *** CALLING STUDENT'S FUNCTION: isBaseInDanger() from 02_Shop.cpp ***
-    bool danger = isBaseInDanger(baseHealth, enemyCount);
+    bool danger = isBaseInDanger(world.baseHealth, world.enemyCount);
     if (danger) {
         // Pulsing danger indicator
         float dangerPulse = 0.5f + 0.5f * sinf(GetTime() * 6);
@@ -881,48 +1242,18 @@ void drawGame() {
     }
     
     // ─────────────────────────────────────────────────────────────────
-    // RADAR PANEL (right side, below wave indicator) - ENLARGED
+    // RADAR, STATUS and COMMANDER panels (redrawn only when changed)
     // ─────────────────────────────────────────────────────────────────
-    std::vector<RadarEnemy> radarData = getRadarEnemies();
-    
-    // Panel: X=560, width=230 (fills right side)
-    DrawRectangleRounded((Rectangle){560, 50, 230, 170}, 0.1f, 8, Fade(BLACK, 0.85f));
-    DrawRoundedRectLines((Rectangle){560, 50, 230, 170}, 0.1f, 8, 2, Fade(YELLOW, 0.7f));
-    DrawTextCustom("RADAR", 580, 58, 24, YELLOW);
-    
-    // *** CALLING STUDENT'S FUNCTION: countAllEnemies() from 04_Radar.cpp ***
-    int totalEnemies = countAllEnemies(radarData);
-    DrawTextCustom(TextFormat("Enemies: %d", totalEnemies), 575, 90, 20, COLOR_UI_TEXT);
-    
-    // *** CALLING STUDENT'S FUNCTION: countCloseEnemies() from 04_Radar.cpp ***
-    int closeEnemies = countCloseEnemies(radarData, 5.0);
-    Color closeColor = (closeEnemies > 2) ? RED : (closeEnemies > 0) ? ORANGE : GREEN;
-    DrawTextCustom(TextFormat("Close: %d", closeEnemies), 575, 115, 20, closeColor);
-    
-    // *** CALLING STUDENT'S FUNCTION: getTotalEnemyHealth() from 04_Radar.cpp ***
-    int totalHP = getTotalEnemyHealth(radarData);
-    DrawTextCustom(TextFormat("Total HP: %d", totalHP), 575, 140, 20, COLOR_ENEMY);
-    
-    // *** CALLING STUDENT'S FUNCTION: findClosestEnemy() from 04_Radar.cpp ***
-    double closestDist = findClosestEnemy(radarData);
-    if (closestDist >= 0 && closestDist < 9999) {
-        Color distColor = (closestDist < 3) ? RED : (closestDist < 6) ? ORANGE : GREEN;
-        DrawTextCustom(TextFormat("Nearest: %.1f", closestDist), 575, 165, 20, distColor);
-    } else {
-        DrawTextCustom("Nearest: ---", 575, 165, 20, GREEN);
-    }
-    
-    // *** CALLING STUDENT'S FUNCTION: findStrongestEnemy() from 04_Radar.cpp ***
-    int strongestHP = findStrongestEnemy(radarData);
-    if (strongestHP > 0) {
-        Color hpColor = (strongestHP > 100) ? RED : (strongestHP > 50) ? ORANGE : COLOR_UI_TEXT;
-        DrawTextCustom(TextFormat("Max HP: %d", strongestHP), 575, 190, 20, hpColor);
-    } else {
-        DrawTextCustom("Max HP: ---", 575, 190, 20, GREEN);
-    }
+    updateRadarPanel(world);
+    updateStatusPanel(world);
+    updateCommanderPanel(world);
+    drawHudPanel(radarPanel);
+    drawHudPanel(statusPanel);
+    drawStatusPanelLabels();
+    drawHudPanel(commanderPanel);
     
     // *** CALLING STUDENT'S FUNCTION: getTowerType() from 02_Shop.cpp ***
-    int affordableType = getTowerType(playerMoney);
+    int affordableType = getTowerType(world.playerMoney);
     const char* typeNames[] = {"---", "BASIC", "ADV", "SUPER"};
     Color typeColors[] = {GRAY, COLOR_TOWER, ORANGE, PURPLE};
     // Tower type shown in top-left area (below money)
@@ -930,304 +1261,211 @@ void drawGame() {
         DrawTextCustom(TextFormat("Build: %s", typeNames[affordableType]), 32, 72, 14, typeColors[affordableType]);
     }
     
-    // ─────────────────────────────────────────────────────────────────
-    // STATUS PANEL (right side, below RADAR) - ENLARGED
-    // Shows VIP & Weekend from 02_Shop.cpp
-    // ─────────────────────────────────────────────────────────────────
-    DrawRectangleRounded((Rectangle){560, 230, 230, 90}, 0.1f, 8, Fade(BLACK, 0.85f));
-    DrawRoundedRectLines((Rectangle){560, 230, 230, 90}, 0.1f, 8, 2, Fade(SKYBLUE, 0.7f));
-    DrawTextCustom("STATUS", 580, 238, 22, SKYBLUE);
-    
-    // *** CALLING STUDENT'S FUNCTION: isVIPPlayer() from 02_Shop.cpp ***
-    bool isVIP = isVIPPlayer(score, wave, false);  // score, wavesCompleted, hasPremium
-    if (isVIP) {
-        float pulse = 0.7f + 0.3f * sinf(GetTime() * 3);
-        DrawTextCustom("VIP", 575, 268, 22, Fade(GOLD, pulse));
-    } else {
-        DrawTextCustom("VIP: ---", 575, 268, 20, GRAY);
-    }
-    
-    // *** CALLING STUDENT'S FUNCTION: calculateDiscount() from 02_Shop.cpp ***
-    // Simulate weekend based on wave number (every 5 waves = "weekend sale")
-    bool isWeekend = (wave % 5 == 0 && wave > 0);
-    int discount = calculateDiscount(score, isWeekend);  // using score as "purchases"
-    
-    if (isWeekend) {
-        float pulse = 0.6f + 0.4f * sinf(GetTime() * 4);
-        DrawTextCustom("WKND", 680, 268, 20, Fade(MAGENTA, pulse));
-    }
-    
-    if (discount > 0) {
-        DrawTextCustom(TextFormat("Discount: -%d%%", discount), 575, 295, 20, GREEN);
-    } else {
-        DrawTextCustom("Discount: ---", 575, 295, 18, GRAY);
-    }
-    
-    // ─────────────────────────────────────────────────────────────────
-    // COMMANDER PANEL (right side, below STATUS) - ENLARGED
-    // ─────────────────────────────────────────────────────────────────
-    std::vector<UpgradeTower> upgradeData = getUpgradeTowers();
-    UpgradePlayer playerData = getUpgradePlayer();
-    
-    DrawRectangleRounded((Rectangle){560, 330, 230, 175}, 0.1f, 8, Fade(BLACK, 0.85f));
-    DrawRoundedRectLines((Rectangle){560, 330, 230, 175}, 0.1f, 8, 2, Fade(PURPLE, 0.7f));
-    DrawTextCustom("COMMANDER", 580, 338, 22, PURPLE);
-    
-    // *** CALLING STUDENT'S FUNCTION: getPlayerRank() from 05_Upgrades.cpp ***
-    std::string playerRank = getPlayerRank(playerData);
-    Color rankColor = (playerRank == "Θρύλος") ? GOLD : 
-                      (playerRank == "Ήρωας") ? PURPLE :
-                      (playerRank == "Βετεράνος") ? ORANGE :
-                      (playerRank == "Μαθητευόμενος") ? COLOR_TOWER : GRAY;
-    DrawTextCustom(playerRank.c_str(), 575, 368, 24, rankColor);
-    DrawTextCustom(TextFormat("Kills: %d", totalPlayerKills), 575, 398, 20, COLOR_UI_TEXT);
-    
-    // *** CALLING STUDENT'S FUNCTION: getTotalFleetDamage() from 05_Upgrades.cpp ***
-    int fleetDamage = getTotalFleetDamage(upgradeData);
-    DrawTextCustom(TextFormat("Fleet DMG: %d", fleetDamage), 575, 425, 18, COLOR_ENEMY);
-    
-    // *** CALLING STUDENT'S FUNCTION: findMVPTower() from 05_Upgrades.cpp ***
-    int mvpIdx = findMVPTower(upgradeData);
-    if (mvpIdx >= 0 && mvpIdx < (int)upgradeData.size()) {
-        DrawTextCustom(TextFormat("MVP: %s", upgradeData[mvpIdx].type.c_str()), 575, 450, 18, GOLD);
-    } else {
-        DrawTextCustom("MVP: ---", 575, 450, 18, GRAY);
-    }
-    
-    // *** CALLING STUDENT'S FUNCTION: recommendTower() from 05_Upgrades.cpp ***
-    bool hasAir = false;
-    std::string recommended = recommendTower(playerMoney, hasAir, wave);
-    Color recColor = (recommended == "plasma") ? PURPLE : 
-                     (recommended == "missile") ? ORANGE :
-                     (recommended == "laser") ? COLOR_TOWER : GRAY;
-    DrawTextCustom(TextFormat("Recommend: %s", recommended.c_str()), 575, 477, 18, recColor);
-
     // ─────────────────────────────────────────────────────────────────
     // THREAT WARNING (only shown when dangerous enemy exists)
     // ─────────────────────────────────────────────────────────────────
-    std::vector<RadarEnemy> threatData = getRadarEnemies();
+    const RadarStats& radar = getRadarStats(world);
     
-    // *** CALLING STUDENT'S FUNCTION: findFirstDangerousEnemy() from 04_Radar.cpp ***
-    int dangerousIdx = findFirstDangerousEnemy(threatData, 75);
-    if (dangerousIdx >= 0 && dangerousIdx < (int)threatData.size()) {
+    // *** STUDENT'S FUNCTION: findFirstDangerousEnemy() from 04_Radar.cpp ***
+    int dangerousIdx = radar.firstDangerous;
+    if (dangerousIdx >= 0 && dangerousIdx < (int)radar.enemies.size()) {
         float pulse = 0.6f + 0.4f * sinf(GetTime() * 5);
         DrawRectangleRounded((Rectangle){(float)(SCREEN_WIDTH / 2 - 80), 75, 160, 25}, 0.3f, 8, Fade(RED, 0.4f * pulse));
         DrawRoundedRectLines((Rectangle){(float)(SCREEN_WIDTH / 2 - 80), 75, 160, 25}, 0.3f, 8, 1, Fade(RED, 0.8f));
-        DrawTextCustom(TextFormat("! THREAT: %d HP !", threatData[dangerousIdx].health), SCREEN_WIDTH / 2 - 65, 80, 16, Fade(WHITE, pulse));
+        DrawTextCustom(TextFormat("! THREAT: %d HP !", radar.enemies[dangerousIdx].health), SCREEN_WIDTH / 2 - 65, 80, 16, Fade(WHITE, pulse));
     }
     
-    // *** CALLING STUDENT'S FUNCTION: countFlyingEnemiesInRange() from 04_Radar.cpp ***
-    int flyingInRange = countFlyingEnemiesInRange(threatData, 5.0);
+    // *** STUDENT'S FUNCTION: countFlyingEnemiesInRange() from 04_Radar.cpp ***
+    int flyingInRange = radar.flyingInRange;
     
     // *** CALLING STUDENT'S FUNCTION: countGridCells() from 04_Radar.cpp ***
-    int totalCells = countGridCells(GRID_SIZE, GRID_SIZE);
+    int totalCells = countGridCells(world.gridWidth, world.gridHeight);
     
     // *** CALLING STUDENT'S FUNCTION: simulateWaiting() from 04_Radar.cpp ***
-    int wavesToMassAttack = simulateWaiting(wave, 20);
+    int wavesToMassAttack = simulateWaiting(world.wave, 20);
     
     // *** CALLING STUDENT'S FUNCTION: calculateDailyBonus() from 05_Upgrades.cpp ***
-    int dayBonus = calculateDailyBonus(playerData, wave);
+    int dayBonus = calculateDailyBonus(getUpgradePlayer(world), world.wave);
     
     // ─────────────────────────────────────────────────────────────────
-    // Draw Grid with subtle glow
+    // MAP (world coordinates, only what is in the viewport)
     // ─────────────────────────────────────────────────────────────────
-    for (int y = 0; y < GRID_SIZE; y++) {
-        for (int x = 0; x < GRID_SIZE; x++) {
-            int screenX = GRID_OFFSET_X + x * CELL_SIZE;
-            int screenY = GRID_OFFSET_Y + y * CELL_SIZE;
-            
-            // Highlight hovered cell with glow
-            if (x == hoveredCellX && y == hoveredCellY && !gameOver) {
-                DrawRectangle(screenX + 2, screenY + 2, CELL_SIZE - 4, CELL_SIZE - 4, 
-                             Fade(COLOR_TOWER, 0.15f + 0.05f * sinf(GetTime() * 4)));
-                DrawRectangleLinesEx((Rectangle){(float)screenX, (float)screenY, CELL_SIZE, CELL_SIZE}, 2, 
-                                     Fade(COLOR_TOWER, 0.6f));
-            } else {
-                // Subtle grid dots at corners
-                DrawCircle(screenX, screenY, 2, Fade(COLOR_GRID, 0.5f));
-            }
-        }
-    }
-    // Grid border
-    DrawRectangleLinesEx((Rectangle){GRID_OFFSET_X - 2, GRID_OFFSET_Y - 2, 
-                         GRID_SIZE * CELL_SIZE + 4, GRID_SIZE * CELL_SIZE + 4}, 2, Fade(COLOR_GRID, 0.8f));
+    beginWorldView(world);
+    collectVisibleTowers(world);
     
     // ─────────────────────────────────────────────────────────────────
-    // Draw Base (right side) with pulsing glow
+    // Highlight hovered cell with glow (grid itself is in the background)
     // ─────────────────────────────────────────────────────────────────
-    int baseScreenX = GRID_OFFSET_X + (GRID_SIZE - 1) * CELL_SIZE;
-    int baseScreenY = GRID_OFFSET_Y + 4 * CELL_SIZE;
-    
-    // Pulsing glow behind base
-    float pulse = 0.5f + 0.3f * sinf(GetTime() * 2);
-    DrawRectangle(baseScreenX - 5, baseScreenY - 5, CELL_SIZE + 10, CELL_SIZE * 2 + 10, 
-                  Fade(COLOR_BASE, pulse * 0.2f));
+    if (isValidGridPos(world, hoveredCellX, hoveredCellY) && !world.gameOver) {
+        int screenX = GRID_OFFSET_X + hoveredCellX * CELL_SIZE;
+        int screenY = GRID_OFFSET_Y + hoveredCellY * CELL_SIZE;
+        DrawRectangle(screenX + 2, screenY + 2, CELL_SIZE - 4, CELL_SIZE - 4, 
+                     Fade(COLOR_TOWER, 0.15f + 0.05f * sinf(GetTime() * 4)));
+        DrawRectangleLinesEx((Rectangle){(float)screenX, (float)screenY, CELL_SIZE, CELL_SIZE}, 2, 
+                             Fade(COLOR_TOWER, 0.6f));
+    }
     
-    // Base body with gradient effect (layered rectangles)
-    DrawRectangle(baseScreenX + 3, baseScreenY + 3, CELL_SIZE - 6, CELL_SIZE * 2 - 6, COLOR_BASE);
-    DrawRectangle(baseScreenX + 8, baseScreenY + 8, CELL_SIZE - 16, CELL_SIZE * 2 - 16, 
-                  Fade(WHITE, 0.2f));
-    DrawRectangleLinesEx((Rectangle){(float)baseScreenX + 3, (float)baseScreenY + 3, 
-                         CELL_SIZE - 6, CELL_SIZE * 2 - 6}, 2, Fade(WHITE, 0.5f));
+    // Cell suggested by [H], until something is built on it
+    if (isValidGridPos(world, hintCellX, hintCellY) && !hasTowerAt(world, hintCellX, hintCellY) && !world.gameOver) {
+        int screenX = GRID_OFFSET_X + hintCellX * CELL_SIZE;
+        int screenY = GRID_OFFSET_Y + hintCellY * CELL_SIZE;
+        DrawRectangleLinesEx((Rectangle){(float)screenX + 3, (float)screenY + 3, CELL_SIZE - 6, CELL_SIZE - 6}, 2,
+                             Fade(GOLD, 0.5f + 0.4f * sinf(GetTime() * 6)));
+    }
     
-    // Base icon (shield shape)
-    Vector2 shieldCenter = {(float)baseScreenX + CELL_SIZE/2, (float)baseScreenY + CELL_SIZE};
-    DrawCircle((int)shieldCenter.x, (int)shieldCenter.y - 10, 12, Fade(WHITE, 0.3f));
-    DrawText("HQ", baseScreenX + 14, baseScreenY + CELL_SIZE - 8, 18, WHITE);
+    // ─────────────────────────────────────────────────────────────────
+    // Base (right side) pulsing glow
+    // ─────────────────────────────────────────────────────────────────
+    // The base body is opaque and cached, so only the visible ring of the
+    // glow around it is drawn (looks the same as the glow behind it)
+    int baseScreenX = GRID_OFFSET_X + (world.gridWidth - 1) * CELL_SIZE;
+    int baseScreenY = GRID_OFFSET_Y + getBaseRow(world) * CELL_SIZE;
+    float pulse = 0.5f + 0.3f * sinf(GetTime() * 2);
+    Color baseGlow = Fade(COLOR_BASE, pulse * 0.2f);
+    DrawRectangle(baseScreenX - 5, baseScreenY - 5, CELL_SIZE + 10, 8, baseGlow);                     // Top
+    DrawRectangle(baseScreenX - 5, baseScreenY + CELL_SIZE * 2 - 3, CELL_SIZE + 10, 8, baseGlow);     // Bottom
+    DrawRectangle(baseScreenX - 5, baseScreenY + 3, 8, CELL_SIZE * 2 - 6, baseGlow);                  // Left
+    DrawRectangle(baseScreenX + CELL_SIZE - 3, baseScreenY + 3, 8, CELL_SIZE * 2 - 6, baseGlow);      // Right
     
     // ─────────────────────────────────────────────────────────────────
     // Draw Towers - Futuristic turrets with upgrade levels
     // ─────────────────────────────────────────────────────────────────
-    for (int i = 0; i < MAX_TOWERS; i++) {
-        if (!towers[i].active) continue;
-        
-        Vector2 pos = gridToScreen(towers[i].gridX, towers[i].gridY);
-        double towerRange = getTowerRange();
+    // Range indicators (subtle fill + line) are plain shapes, so they go
+    // first; the turrets themselves come from the sprite atlas
+    for (int i : visibleTowers) {
+        Vector2 pos = gridToScreen(world.towers[i].gridX, world.towers[i].gridY);
+        double towerRange = world.economy.towerRange;
         
         // *** CALLING STUDENT'S FUNCTION: getUpgradedRange() from 05_Upgrades.cpp ***
         // Apply range upgrade based on level
         UpgradeTower ut;
-        ut.level = towers[i].level;
+        ut.level = world.towers[i].level;
         ut.range = towerRange;
-        ut.damage = getTowerBaseDamage();
-        ut.type = towers[i].type;
-        ut.kills = towers[i].kills;
+        ut.damage = world.economy.towerBaseDamage;
+        ut.type = world.towers[i].type;
+        ut.kills = world.towers[i].kills;
         double upgradedRange = getUpgradedRange(ut);
         if (upgradedRange > towerRange) towerRange = upgradedRange;
         
-        // Tower color based on type
-        Color towerColor = COLOR_TOWER;
-        Color towerDark = COLOR_TOWER_DARK;
-        if (towers[i].type == "missile") { towerColor = ORANGE; towerDark = (Color){180, 100, 30, 255}; }
-        else if (towers[i].type == "plasma") { towerColor = PURPLE; towerDark = (Color){100, 50, 150, 255}; }
-        
-        // Draw range indicator (subtle fill + line)
+        Color towerColor, towerDark;
+        getTowerColors(world.towers[i].type, &towerColor, &towerDark);
         DrawCircle((int)pos.x, (int)pos.y, (float)(towerRange * CELL_SIZE), 
                    Fade(towerColor, 0.05f));
         DrawCircleLines((int)pos.x, (int)pos.y, (float)(towerRange * CELL_SIZE), 
                         Fade(towerColor, 0.3f));
+    }
+    
+    // All sprites below come from one texture: one batch, one draw call
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    
+    for (int i : visibleTowers) {
+        Vector2 pos = gridToScreen(world.towers[i].gridX, world.towers[i].gridY);
+        int look = (world.towers[i].type == "missile") ? 1 : (world.towers[i].type == "plasma") ? 2 : 0;
         
         // Tower base (octagon-like using circle)
-        DrawCircle((int)pos.x, (int)pos.y + 5, 18, Fade(BLACK, 0.5f));  // Shadow
-        DrawCircle((int)pos.x, (int)pos.y, 18, towerDark);
-        DrawCircle((int)pos.x, (int)pos.y, 14, towerColor);
-        DrawCircle((int)pos.x, (int)pos.y, 8, Fade(WHITE, 0.3f));  // Highlight
+        drawSprite((SpriteId)(SPRITE_TOWER_LASER + look), pos.x, pos.y, 0, 1, WHITE);
         
         // Rotating cannon (based on time + level for faster rotation)
-        float angle = GetTime() * (0.5f + towers[i].level * 0.2f) + i;
-        float cannonLen = 16 + towers[i].level;  // Longer cannon at higher levels
-        Vector2 cannonEnd = {
-            pos.x + cosf(angle) * cannonLen,
-            pos.y + sinf(angle) * cannonLen
-        };
-        DrawLineEx(pos, cannonEnd, 6, towerDark);
-        DrawLineEx(pos, cannonEnd, 3, towerColor);
+        float angle = GetTime() * (0.5f + world.towers[i].level * 0.2f) + i;
+        float cannonLen = 16 + world.towers[i].level;  // Longer cannon at higher levels
+        drawSprite((SpriteId)(SPRITE_CANNON_LASER + look), pos.x, pos.y, angle * RAD2DEG,
+                   cannonLen / CANNON_BAKE_LENGTH, WHITE);
         
         // Glowing core (brighter at higher levels)
-        DrawCircle((int)pos.x, (int)pos.y, 4, Fade(WHITE, 0.8f + 0.2f * sinf(GetTime() * 5 + i)));
-        
-        // Show level indicator
-        if (towers[i].level > 1) {
-            DrawText(TextFormat("L%d", towers[i].level), (int)pos.x - 8, (int)pos.y - 30, 10, GOLD);
-        }
-        
-        // *** CALLING STUDENT'S FUNCTION: getBonusDamageFromKills() from 05_Upgrades.cpp ***
-        int bonusDmg = getBonusDamageFromKills(ut);
-        if (bonusDmg > 0) {
-            DrawText(TextFormat("+%d", bonusDmg), (int)pos.x + 12, (int)pos.y - 20, 9, COLOR_MONEY);
-        }
+        drawSprite(SPRITE_TOWER_CORE, pos.x, pos.y, 0, 1, Fade(WHITE, 0.8f + 0.2f * sinf(GetTime() * 5 + i)));
     }
     
     // ─────────────────────────────────────────────────────────────────
     // Draw Enemies - Alien invaders
     // ─────────────────────────────────────────────────────────────────
-    for (int i = 0; i < MAX_ENEMIES; i++) {
-        if (!enemies[i].alive) continue;
-        
-        float ex = enemies[i].x;
-        float ey = enemies[i].y;
+    for (int i = 0; i < world.enemies.count; i++) {
+        float ex = world.enemies.x[i];
+        float ey = world.enemies.y[i];
+        if (!isInView(ex, ey, CELL_SIZE)) continue;
+        int phase = world.enemies.id[i];  // Stable per enemy, unlike its slot
         
         // Pulsing glow behind enemy
-        float glow = 0.3f + 0.1f * sinf(GetTime() * 4 + i);
-        DrawCircle((int)ex, (int)ey, 22, Fade(COLOR_ENEMY, glow));
-        
-        // Enemy body with shading
-        DrawCircle((int)ex + 2, (int)ey + 2, 16, Fade(BLACK, 0.4f));  // Shadow
-        DrawCircle((int)ex, (int)ey, 16, COLOR_ENEMY_DARK);
-        DrawCircle((int)ex, (int)ey, 12, COLOR_ENEMY);
+        float glow = 0.3f + 0.1f * sinf(GetTime() * 4 + phase);
+        drawSprite(SPRITE_ENEMY_GLOW, ex, ey, 0, 1, Fade(WHITE, glow));
         
-        // Evil eye
-        DrawCircle((int)ex, (int)ey, 6, Fade(BLACK, 0.5f));
-        DrawCircle((int)ex + 2, (int)ey - 1, 3, Fade(WHITE, 0.9f));
+        // Enemy body with shading and evil eye
+        drawSprite(SPRITE_ENEMY_BODY, ex, ey, 0, 1, WHITE);
         
         // Spikes (triangle shapes pointing outward)
-        float spikeAngle = GetTime() * 2 + i;
-        for (int s = 0; s < 3; s++) {
-            float a = spikeAngle + s * 2.094f;  // 120 degrees apart
-            Vector2 p1 = {ex + cosf(a) * 14, ey + sinf(a) * 14};
-            Vector2 p2 = {ex + cosf(a - 0.3f) * 8, ey + sinf(a - 0.3f) * 8};
-            Vector2 p3 = {ex + cosf(a + 0.3f) * 8, ey + sinf(a + 0.3f) * 8};
-            DrawTriangle(p1, p2, p3, COLOR_ENEMY);
-        }
+        float spikeAngle = GetTime() * 2 + phase;
+        drawSprite(SPRITE_ENEMY_SPIKES, ex, ey, spikeAngle * RAD2DEG, 1, WHITE);
         
         // Health bar with nicer style
-        int maxHealth = 50 + wave * 10;
-        float healthPercent = (float)enemies[i].health / maxHealth;
-        DrawRectangleRounded((Rectangle){ex - 16, ey - 28, 32, 6}, 0.5f, 4, Fade(BLACK, 0.7f));
+        int maxHealth = 50 + world.wave * 10;
+        float healthPercent = (float)world.enemies.health[i] / maxHealth;
+        drawSprite(SPRITE_BAR_BACK, ex - 16, ey - 28, 0, 1, WHITE);
         if (healthPercent > 0) {
             Color hpColor = healthPercent > 0.5f ? COLOR_ENEMY_HEALTH : 
                            (healthPercent > 0.25f ? ORANGE : RED);
-            DrawRectangleRounded((Rectangle){ex - 15, ey - 27, 30 * healthPercent, 4}, 0.5f, 4, hpColor);
+            drawSprite(SPRITE_BAR_FILL, ex - 15, ey - 27, 0, healthPercent, hpColor);
         }
     }
     
     // ─────────────────────────────────────────────────────────────────
     // Draw Projectiles - Laser beams
     // ─────────────────────────────────────────────────────────────────
-    for (int i = 0; i < MAX_PROJECTILES; i++) {
-        if (!projectiles[i].active) continue;
+    for (int i = 0; i < world.projectiles.capacity(); i++) {
+        if (!world.projectiles[i].active) continue;
+        if (!isInView(world.projectiles[i].x, world.projectiles[i].y, CELL_SIZE)) continue;
         
-        // Calculate direction for trail
-        float dx = projectiles[i].targetX - projectiles[i].x;
-        float dy = projectiles[i].targetY - projectiles[i].y;
-        float dist = sqrtf(dx * dx + dy * dy);
-        if (dist > 0) {
-            dx /= dist; dy /= dist;
+        // Laser trail points back along the direction of flight
+        float dx = world.projectiles[i].targetX - world.projectiles[i].x;
+        float dy = world.projectiles[i].targetY - world.projectiles[i].y;
+        if (dx != 0 || dy != 0) {
+            drawSprite(SPRITE_PROJECTILE_TRAIL, world.projectiles[i].x, world.projectiles[i].y, atan2f(dy, dx) * RAD2DEG, 1, WHITE);
         }
         
-        // Draw laser trail (line from slightly behind)
-        Vector2 trailStart = {projectiles[i].x - dx * 15, projectiles[i].y - dy * 15};
-        Vector2 trailEnd = {projectiles[i].x, projectiles[i].y};
+        // Projectile head with glow
+        drawSprite(SPRITE_PROJECTILE_HEAD, world.projectiles[i].x, world.projectiles[i].y, 0, 1, WHITE);
+    }
+    
+    EndBlendMode();
+    
+    // Tower labels (text uses the font texture, so it is drawn after the batch)
+    for (int i : visibleTowers) {
+        Vector2 pos = gridToScreen(world.towers[i].gridX, world.towers[i].gridY);
         
-        // Glow layer
-        DrawLineEx(trailStart, trailEnd, 8, COLOR_PROJECTILE_GLOW);
-        // Core beam
-        DrawLineEx(trailStart, trailEnd, 3, COLOR_PROJECTILE);
-        // Bright center
-        DrawLineEx(trailStart, trailEnd, 1, WHITE);
+        // Show level indicator
+        if (world.towers[i].level > 1) {
+            DrawText(TextFormat("L%d", world.towers[i].level), (int)pos.x - 8, (int)pos.y - 30, 10, GOLD);
+        }
         
-        // Projectile head with glow
-        DrawCircle((int)projectiles[i].x, (int)projectiles[i].y, 6, COLOR_PROJECTILE_GLOW);
-        DrawCircle((int)projectiles[i].x, (int)projectiles[i].y, 3, COLOR_PROJECTILE);
-        DrawCircle((int)projectiles[i].x, (int)projectiles[i].y, 1, WHITE);
+        // *** CALLING STUDENT'S FUNCTION: getBonusDamageFromKills() from 05_Upgrades.cpp ***
+        UpgradeTower ut;
+        ut.level = world.towers[i].level;
+        ut.range = world.economy.towerRange;
+        ut.damage = world.economy.towerBaseDamage;
+        ut.type = world.towers[i].type;
+        ut.kills = world.towers[i].kills;
+        int bonusDmg = getBonusDamageFromKills(ut);
+        if (bonusDmg > 0) {
+            DrawText(TextFormat("+%d", bonusDmg), (int)pos.x + 12, (int)pos.y - 20, 9, COLOR_MONEY);
+        }
     }
     
+    endWorldView(world);
+    
     // ─────────────────────────────────────────────────────────────────
     // Draw Status Message (positioned well above controls)
     // ─────────────────────────────────────────────────────────────────
-    if (messageTimer > 0) {
-        float alpha = messageTimer > 1 ? 1.0f : messageTimer;
+    if (world.messageTimer > 0) {
+        float alpha = world.messageTimer > 1 ? 1.0f : world.messageTimer;
         DrawRectangleRounded((Rectangle){15, (float)(SCREEN_HEIGHT - 68), (float)(SCREEN_WIDTH - 200), 28}, 
                              0.3f, 8, Fade(BLACK, 0.9f * alpha));
         DrawRoundedRectLines((Rectangle){15, (float)(SCREEN_HEIGHT - 68), (float)(SCREEN_WIDTH - 200), 28}, 
                                   0.3f, 8, 1, Fade(COLOR_TOWER, 0.7f * alpha));
-        DrawTextCustom(statusMessage.c_str(), 25, SCREEN_HEIGHT - 62, 18, Fade(WHITE, alpha));
+        DrawTextCustom(world.statusMessage.c_str(), 25, SCREEN_HEIGHT - 62, 18, Fade(WHITE, alpha));
     }
     
     // ─────────────────────────────────────────────────────────────────
     // Draw BUTTON BAR (at very bottom)
     // ─────────────────────────────────────────────────────────────────
-    int towerCost = getTowerCost();
+    int towerCost = world.economy.towerCost;
     DrawRectangle(0, SCREEN_HEIGHT - 45, SCREEN_WIDTH, 45, Fade(BLACK, 0.85f));
     DrawRectangle(0, SCREEN_HEIGHT - 45, SCREEN_WIDTH, 2, Fade(COLOR_TOWER, 0.5f));
     
@@ -1243,12 +1481,8 @@ void drawGame() {
     // Button: AUTO-UPGRADE [U]
     btnAutoUpgrade = (Rectangle){130, (float)(SCREEN_HEIGHT - 50), 130, 42};
     bool hoverAutoUpgrade = CheckCollisionPointRec(mousePos, btnAutoUpgrade);
-    // Check if student solved autoUpgradeAll (test with small budget)
-    std::vector<UpgradeTower> testTowers;
-    UpgradeTower testT; testT.level = 1; testT.damage = 10; testT.range = 2.0; testT.type = "laser"; testT.kills = 0;
-    testTowers.push_back(testT);
-    int testResult = autoUpgradeAll(testTowers, 1000);
-    bool autoUpgradeSolved = (testResult < 1000);  // If money was spent, function works!
+    // Did the student solve autoUpgradeAll? (probed once at startup)
+    bool autoUpgradeSolved = isExerciseSolved(EX_AUTO_UPGRADE_ALL);
     
     Color btnAutoColor = autoUpgradeSolved ? PURPLE : DARKGRAY;
     DrawRectangleRounded(btnAutoUpgrade, 0.3f, 8, hoverAutoUpgrade ? Fade(btnAutoColor, 0.9f) : Fade(btnAutoColor, 0.5f));
@@ -1261,9 +1495,9 @@ void drawGame() {
     // ─────────────────────────────────────────────────────────────────
     // Draw UPGRADE PANEL (when tower selected)
     // ─────────────────────────────────────────────────────────────────
-    if (showUpgradePanel && selectedTowerIndex >= 0 && selectedTowerIndex < MAX_TOWERS && towers[selectedTowerIndex].active) {
-        Tower& selTower = towers[selectedTowerIndex];
-        Vector2 towerPos = gridToScreen(selTower.gridX, selTower.gridY);
+    if (showUpgradePanel && selectedTowerIndex >= 0 && selectedTowerIndex < world.towers.capacity() && world.towers[selectedTowerIndex].active) {
+        const Tower& selTower = world.towers[selectedTowerIndex];
+        Vector2 towerPos = GetWorldToScreen2D(gridToScreen(selTower.gridX, selTower.gridY), camera);
         
         // Panel position (near selected tower but not overlapping)
         float panelX = towerPos.x + 30;
@@ -1282,17 +1516,17 @@ void drawGame() {
         // Create upgrade tower data for checking
         UpgradeTower ut;
         ut.level = selTower.level;
-        ut.damage = getTowerBaseDamage();
-        ut.range = getTowerRange();
+        ut.damage = world.economy.towerBaseDamage;
+        ut.range = world.economy.towerRange;
         ut.type = selTower.type;
         ut.kills = selTower.kills;
         
         int upgradeCost = getUpgradeCost(ut);
-        bool canUpg = canUpgrade(ut, playerMoney);
+        bool canUpg = canUpgrade(ut, world.playerMoney);
         
         // Show upgrade cost
         DrawTextCustom(TextFormat("Cost: $%d", upgradeCost), (int)panelX + 10, (int)panelY + 42, 12, 
-                       (playerMoney >= upgradeCost) ? COLOR_MONEY : RED);
+                       (world.playerMoney >= upgradeCost) ? COLOR_MONEY : RED);
         
         // UPGRADE button
         btnUpgradeTower = (Rectangle){panelX + 10, panelY + 58, 120, 28};
@@ -1313,17 +1547,21 @@ void drawGame() {
         }
         
         // Selection highlight on tower
-        DrawCircleLines((int)towerPos.x, (int)towerPos.y, 25, Fade(COLOR_TOWER, 0.5f + 0.3f * sinf(GetTime() * 4)));
+        DrawCircleLines((int)towerPos.x, (int)towerPos.y, 25 * camera.zoom, Fade(COLOR_TOWER, 0.5f + 0.3f * sinf(GetTime() * 4)));
     }
     
     // Help text
-    DrawTextCustom("[CLICK] Build/Select  [ESC] Deselect  [SPACE] Pause", 
+    DrawTextCustom("[CLICK] Build/Select  [ESC] Deselect  [SPACE] Pause  [E] Exercises", 
                    275, SCREEN_HEIGHT - 38, 16, Fade(COLOR_UI_TEXT, 0.8f));
     
+    if (showExercisePanel) {
+        drawExercisePanel();
+    }
+    
     // ─────────────────────────────────────────────────────────────────
     // Draw Pause / Game Over Overlay
     // ─────────────────────────────────────────────────────────────────
-    if (gamePaused && !gameOver) {
+    if (world.gamePaused && !world.gameOver) {
         DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.8f));
         
         // Pause panel
@@ -1336,7 +1574,7 @@ void drawGame() {
         DrawTextCustom("Press SPACE to continue", SCREEN_WIDTH/2 - 105, SCREEN_HEIGHT/2 + 20, 18, COLOR_UI_TEXT);
     }
     
-    if (gameOver) {
+    if (world.gameOver) {
         // Animated background
         DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.85f));
         
@@ -1358,8 +1596,8 @@ void drawGame() {
         DrawTextCustom("GAME OVER", SCREEN_WIDTH/2 - 108, SCREEN_HEIGHT/2 - 77, 44, Fade(COLOR_ENEMY, 0.5f));
         DrawTextCustom("GAME OVER", SCREEN_WIDTH/2 - 110, SCREEN_HEIGHT/2 - 80, 44, WHITE);
         
-        DrawTextCustom(TextFormat("Score: %d", score), SCREEN_WIDTH/2 - 55, SCREEN_HEIGHT/2 - 15, 26, COLOR_MONEY);
-        DrawTextCustom(TextFormat("Waves Survived: %d", wave - 1), SCREEN_WIDTH/2 - 85, SCREEN_HEIGHT/2 + 25, 20, COLOR_UI_TEXT);
+        DrawTextCustom(TextFormat("Score: %d", world.score), SCREEN_WIDTH/2 - 55, SCREEN_HEIGHT/2 - 15, 26, COLOR_MONEY);
+        DrawTextCustom(TextFormat("Waves Survived: %d", world.wave - 1), SCREEN_WIDTH/2 - 85, SCREEN_HEIGHT/2 + 25, 20, COLOR_UI_TEXT);
         
         // Pulsing restart hint
         float hintAlpha = 0.5f + 0.5f * sinf(GetTime() * 4);
@@ -1373,7 +1611,32 @@ void drawGame() {
 // MAIN ENTRY POINT
 // ═══════════════════════════════════════════════════════════════════════
 
-int main() {
+// Command line: game [--seed N] [--record FILE] [--max-towers N] [--max-enemies N] [--grid WxH] [--threads N]
+//   --record FILE  save every input to FILE on exit (replay it with
+//                  the headless runner: headless --replay FILE)
+//   --max-towers N / --max-enemies N  capacities for stress-test games
+//   --grid WxH     map size in cells (or N for NxN), scrolled with the arrow keys
+//   --threads N    tower targeting threads (default: one per core)
+int main(int argc, char** argv) {
+    GameWorld world;   // The game shown in the window (all of its state, see Simulation.h)
+    TowerHintSearch hintSearch;   // Branch worlds of the [H] hint (see startHintSearch())
+    uint64_t seed = (uint64_t)time(nullptr);  // Every session gets its own seed
+    const char* recordPath = nullptr;
+    int threads = 0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--seed") == 0) seed = strtoull(argv[i + 1], nullptr, 10);
+        else if (strcmp(argv[i], "--record") == 0) recordPath = argv[i + 1];
+        else if (strcmp(argv[i], "--max-towers") == 0) setCapacity(world, atoi(argv[i + 1]), world.maxEnemies);
+        else if (strcmp(argv[i], "--max-enemies") == 0) setCapacity(world, world.maxTowers, atoi(argv[i + 1]));
+        else if (strcmp(argv[i], "--grid") == 0) {
+            int width = 0, height = 0;
+            if (sscanf(argv[i + 1], "%dx%d", &width, &height) == 1) height = width;
+            setGridSize(world, width, height);
+        }
+        else if (strcmp(argv[i], "--threads") == 0) threads = atoi(argv[i + 1]);
+    }
+    startJobSystem(threads);
+    
     // Initialize Raylib window
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Planetary Defense Command");
     SetTargetFPS(60);
@@ -1396,21 +1659,42 @@ int main() {
     // This function is implemented by the student in 01_Economy.cpp
     // SetupEconomy();  // Uncomment when student completes Challenge 1
     
+    // Check once which exercises are solved (the UI only reads the results)
+    probeExercises();
+    
+    // Pre-render every entity look into the sprite atlas
+    loadSpriteAtlas();
+    loadBackground();
+    
     // Initialize game state
-    initGame();
+    initGame(world, seed);
+    resetView(world);
+    if (recordPath) startRecording(world);
     
     // ─────────────────────────────────────────────────────────────────
     // MAIN GAME LOOP (Raylib style!)
     // ─────────────────────────────────────────────────────────────────
+    // Rendering runs at the monitor/FPS rate; the simulation runs in
+    // fixed SIM_TICK_SECONDS steps, as many as the frame time covers.
     while (!WindowShouldClose()) {
-        float deltaTime = GetFrameTime();
-        
-        handleInput();
-        updateGame(deltaTime);
-        drawGame();
+        handleInput(world, hintSearch);
+        updateHintSearch(world, hintSearch);
+        advanceSimulation(world, GetFrameTime());
+        drawGame(world);
     }
     
     // Cleanup
+    if (recordPath) {
+        if (saveReplay(recordPath, getRecording(world))) {
+            printf("Session recorded to %s\n", recordPath);
+        } else {
+            printf("Could not write replay file %s\n", recordPath);
+        }
+    }
+    unloadSpriteAtlas();
+    unloadBackground();
+    unloadHudPanels();
+    clearTextCache();
     if (fontLoaded) UnloadFont(gameFont);
     CloseWindow();
     
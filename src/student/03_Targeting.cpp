@@ -23,6 +23,10 @@
  *        return a + b;
  *    }
  *
+ *  ΠΡΟΣΟΧΗ: Κάθε πύργος καλεί αυτές τις συναρτήσεις την ίδια στιγμή
+ *  με τους άλλους (σε πολλά threads). Υπολόγισε το αποτέλεσμα ΜΟΝΟ από
+ *  τις παραμέτρους: χωρίς static ή global μεταβλητές και χωρίς cout.
+ *
  * ═══════════════════════════════════════════════════════════════════════
  */
 